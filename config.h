@@ -53,14 +53,17 @@
 #define UTIL_WEIGHT .60
 
 /* 
- * Alignment requirement in bytes (either 4 or 8) 
+ * Alignment requirement in bytes (8, or 16 when built with ALIGNMENT=16) 
  */
+#ifndef ALIGNMENT
 #define ALIGNMENT 8  
+#endif
 
 /* 
  * Maximum heap size in bytes 
  */
-#define MAX_HEAP (20*(1<<20))  /* 20 MB */
+#define MAX_HEAP (40*(1<<20))  /* 40 MB, the largest suggested heap of the traces */
+#define MAX_REGIONS 16         /* most disjoint heap regions memlib hands out */
 
 /*****************************************************************************
  * Set exactly one of these USE_xxx constants to "1" to select a timing method
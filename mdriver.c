@@ -17,6 +17,7 @@
 #include <time.h>
 
 #include "mm.h"
+#include "tcache.h"
 #include "memlib.h"
 #include "fsecs.h"
 #include "config.h"
@@ -31,7 +32,15 @@
 #define LINENUM(i) (i+5) /* cnvt trace request nums to linenums (origin 1) */
 
 /* Returns true if p is ALIGNMENT-byte aligned */
-#define IS_ALIGNED(p)  ((((unsigned int)(p)) % ALIGNMENT) == 0)
+#define IS_ALIGNED(p)  ((((size_t)(p)) % ALIGNMENT) == 0)
+
+/* The block an op's MALLOC_NEAR hint names, or NULL */
+#define NEAR_OF(trace, i) (((trace)->ops[i].flags & MALLOC_NEAR) ? \
+			   (trace)->blocks[(trace)->ops[i].near] : NULL)
+
+/* Granules the locality of MALLOC_NEAR blocks is measured in */
+#define NEAR_LINE   64   /* cache line */
+#define NEAR_PAGE 4096   /* page */
 
 /****************************** 
  * The key compound data types 
@@ -46,9 +55,13 @@ typedef struct range_t {
 
 /* Characterizes a single trace operation (allocator request) */
 typedef struct {
-    enum {ALLOC, FREE, REALLOC} type; /* type of request */
+    enum {ALLOC, FREE, REALLOC, MEMALIGN, BATCH_ALLOC, BATCH_FREE, ALLOC_FLAGS} type; /* type of request */
     int index;                        /* index for free() to use later */
     int size;                         /* byte size of alloc/realloc request */
+    int align;                        /* alignment of a memalign request */
+    int count;                        /* number of blocks (ids index..index+count-1) in a batch request */
+    int flags;                        /* MALLOC_* hints of an alloc_flags request */
+    int near;                         /* id of the block an alloc_flags request belongs next to, or -1 */
 } traceop_t;
 
 /* Holds the information for one trace file*/
@@ -56,6 +69,7 @@ typedef struct {
     int sugg_heapsize;   /* suggested heap size (unused) */
     int num_ids;         /* number of alloc/realloc ids */
     int num_ops;         /* number of distinct requests */
+    int num_requests;    /* number of blocks allocated or freed, each block of a batch counted once */
     int weight;          /* weight for this trace (unused) */
     traceop_t *ops;      /* array of requests */
     char **blocks;       /* array of ptrs returned by malloc/realloc... */
@@ -81,6 +95,8 @@ typedef struct {
 
     /* defined only for the student malloc package */
     double util;     /* space utilization for this trace (always 0 for libc) */
+    double peak;     /* largest heap size in bytes during the util run (0 for libc) */
+    double heap;     /* heap size in bytes left after the util run (0 for libc) */
 
     /* Note: secs and util are only defined if valid is true */
 } stats_t; 
@@ -92,6 +108,27 @@ int verbose = 0;        /* global flag for verbose output */
 static int errors = 0;  /* number of errs found when running student malloc */
 char msg[MAXLINE];      /* for whenever we need to compose an error message */
 
+/* Where the util run put the blocks of alloc_flags requests that name a neighbour */
+static struct {
+    int named;          /* alloc_flags requests that name a neighbour */
+    int page;           /* ... that landed in the page of the named block */
+    int line;           /* ... that share or border a cache line with it */
+} near_stats;
+
+/* The package under test: the mm package, or the thread-local cache over it (-c) */
+static int tcache = 0;
+static int sized_free = 0;      /* free with mm_free_sized and the request size (-s) */
+static int (*init_fn)(void) = mm_init;
+static void *(*malloc_fn)(size_t size) = mm_malloc;
+static void (*free_fn)(void *ptr) = mm_free;
+static void (*free_sized_fn)(void *ptr, size_t size) = mm_free_sized;
+static size_t (*usable_fn)(void *ptr) = mm_usable_size;
+static void *(*realloc_fn)(void *ptr, size_t size) = mm_realloc;
+static void *(*memalign_fn)(size_t alignment, size_t size) = mm_memalign;
+static size_t (*malloc_batch_fn)(size_t size, size_t n, void **out) = mm_malloc_batch;
+static void (*free_batch_fn)(void **ptrs, size_t n) = mm_free_batch;
+static void *(*malloc_flags_fn)(size_t size, int flags, void *near) = mm_malloc_flags;
+
 /* Directory where default tracefiles are found */
 static char tracedir[MAXLINE] = TRACEDIR;
 
@@ -109,6 +146,7 @@ static char *default_tracefiles[] = {
 static int add_range(range_t **ranges, char *lo, int size, 
 		     int tracenum, int opnum);
 static void remove_range(range_t **ranges, char *lo);
+static int usable_size(char *p, int size, int tracenum, int opnum);
 static void clear_ranges(range_t **ranges);
 
 /* These functions read, allocate, and free storage for traces */
@@ -121,12 +159,15 @@ static void eval_libc_speed(void *ptr);
 
 /* Routines for evaluating correctnes, space utilization, and speed 
    of the student's malloc package in mm.c */
+static void eval_mm(int num_tracefiles, char **tracefiles, stats_t *stats);
 static int eval_mm_valid(trace_t *trace, int tracenum, range_t **ranges);
 static double eval_mm_util(trace_t *trace, int tracenum, range_t **ranges);
 static void eval_mm_speed(void *ptr);
 
 /* Various helper routines */
 static void printresults(int n, stats_t *stats);
+static void printcompare(int n, stats_t *first, stats_t *next);
+static void set_place(char *spec);
 static void usage(void);
 static void unix_error(char *msg);
 static void malloc_error(int tracenum, int opnum, char *msg);
@@ -142,13 +183,14 @@ int main(int argc, char **argv)
     char **tracefiles = NULL;  /* null-terminated array of trace file names */
     int num_tracefiles = 0;    /* the number of traces in that array */
     trace_t *trace = NULL;     /* stores a single trace file in memory */
-    range_t *ranges = NULL;    /* keeps track of block extents for one trace */
     stats_t *libc_stats = NULL;/* libc stats for each trace */
     stats_t *mm_stats = NULL;  /* mm (i.e. student) stats for each trace */
+    stats_t *next_stats = NULL;/* mm stats with next fit, for -n */
     speed_t speed_params;      /* input parameters to the xx_speed routines */ 
 
     int team_check = 1;  /* If set, check team structure (reset by -a) */
     int run_libc = 0;    /* If set, run libc malloc (set by -l) */
+    int run_next = 0;    /* If set, run the mm package with next fit as well (set by -n) */
     int autograder = 0;  /* If set, emit summary info for autograder (-g) */
 
     /* temporaries used to compute the performance index */
@@ -158,7 +200,7 @@ int main(int argc, char **argv)
     /* 
      * Read and interpret the command line arguments 
      */
-    while ((c = getopt(argc, argv, "f:t:hvVgal")) != EOF) {
+    while ((c = getopt(argc, argv, "f:t:c:p:hvVganls")) != EOF) {
         switch (c) {
 	case 'g': /* Generate summary info for the autograder */
 	    autograder = 1;
@@ -171,6 +213,26 @@ int main(int argc, char **argv)
             tracefiles[0] = strdup(optarg);
             tracefiles[1] = NULL;
             break;
+	case 'c': /* Run the mm package behind the thread-local cache */
+	    tcache = 1;
+	    tc_set_cap(atoi(optarg));
+	    init_fn = tc_init;
+	    malloc_fn = tc_malloc;
+	    free_fn = tc_free;
+	    free_sized_fn = tc_free_sized;
+	    usable_fn = tc_usable_size;
+	    realloc_fn = tc_realloc;
+	    memalign_fn = tc_memalign;
+	    malloc_batch_fn = tc_malloc_batch;
+	    free_batch_fn = tc_free_batch;
+	    malloc_flags_fn = tc_malloc_flags;
+	    break;
+	case 's': /* Free through the sized entry point */
+	    sized_free = 1;
+	    break;
+	case 'p': /* Placement rule for the mm package */
+	    set_place(optarg);
+	    break;
 	case 't': /* Directory where the traces are located */
 	    if (num_tracefiles == 1) /* ignore if -f already encountered */
 		break;
@@ -184,6 +246,9 @@ int main(int argc, char **argv)
         case 'l': /* Run libc malloc */
             run_libc = 1;
             break;
+        case 'n': /* Run the mm package with next fit as well */
+            run_next = 1;
+            break;
         case 'v': /* Print per-trace performance breakdown */
             verbose = 1;
             break;
@@ -253,7 +318,7 @@ int main(int argc, char **argv)
 	/* Evaluate the libc malloc package using the K-best scheme */
 	for (i=0; i < num_tracefiles; i++) {
 	    trace = read_trace(tracedir, tracefiles[i]);
-	    libc_stats[i].ops = trace->num_ops;
+	    libc_stats[i].ops = trace->num_requests;
 	    if (verbose > 1)
 		printf("Checking libc malloc for correctness, ");
 	    libc_stats[i].valid = eval_libc_valid(trace, i);
@@ -288,24 +353,7 @@ int main(int argc, char **argv)
     mem_init(); 
 
     /* Evaluate student's mm malloc package using the K-best scheme */
-    for (i=0; i < num_tracefiles; i++) {
-	trace = read_trace(tracedir, tracefiles[i]);
-	mm_stats[i].ops = trace->num_ops;
-	if (verbose > 1)
-	    printf("Checking mm_malloc for correctness, ");
-	mm_stats[i].valid = eval_mm_valid(trace, i, &ranges);
-	if (mm_stats[i].valid) {
-	    if (verbose > 1)
-		printf("efficiency, ");
-	    mm_stats[i].util = eval_mm_util(trace, i, &ranges);
-	    speed_params.trace = trace;
-	    speed_params.ranges = ranges;
-	    if (verbose > 1)
-		printf("and performance.\n");
-	    mm_stats[i].secs = fsecs(eval_mm_speed, &speed_params);
-	}
-	free_trace(trace);
-    }
+    eval_mm(num_tracefiles, tracefiles, mm_stats);
 
     /* Display the mm results in a compact table */
     if (verbose) {
@@ -314,6 +362,29 @@ int main(int argc, char **argv)
 	printf("\n");
     }
 
+    /*
+     * Optionally run the mm package again with next fit and compare
+     * it with the default first fit. The performance index below is
+     * still the first fit one.
+     */
+    if (run_next) {
+	if (verbose > 1)
+	    printf("\nTesting mm malloc with next fit\n");
+	next_stats = (stats_t *)calloc(num_tracefiles, sizeof(stats_t));
+	if (next_stats == NULL)
+	    unix_error("next_stats calloc in main failed");
+	mm_set_fit(FIT_NEXT);
+	eval_mm(num_tracefiles, tracefiles, next_stats);
+	mm_set_fit(FIT_FIRST);
+	if (verbose) {
+	    printf("\nResults for mm malloc with next fit:\n");
+	    printresults(num_tracefiles, next_stats);
+	}
+	printf("\nNext fit against first fit:\n");
+	printcompare(num_tracefiles, mm_stats, next_stats);
+	printf("\n");
+    }
+
     /* 
      * Accumulate the aggregate statistics for the student's mm package 
      */
@@ -383,6 +454,7 @@ static int add_range(range_t **ranges, char *lo, int size,
 {
     char *hi = lo + size - 1;
     range_t *p;
+    int region;
     char msg[MAXLINE];
 
     assert(size > 0);
@@ -395,9 +467,10 @@ static int add_range(range_t **ranges, char *lo, int size,
         return 0;
     }
 
-    /* The payload must lie within the extent of the heap */
-    if ((lo < (char *)mem_heap_lo()) || (lo > (char *)mem_heap_hi()) || 
-	(hi < (char *)mem_heap_lo()) || (hi > (char *)mem_heap_hi())) {
+    /* The payload must lie within the extent of one heap region or one mapping */
+    region = mem_region_of(lo);
+    if ((region < 0 || mem_region_of(hi) != region) &&
+	((region = mem_mapping_of(lo)) < 0 || mem_mapping_of(hi) != region)) {
 	sprintf(msg, "Payload (%p:%p) lies outside heap (%p:%p)",
 		lo, hi, mem_heap_lo(), mem_heap_hi());
 	malloc_error(tracenum, opnum, msg);
@@ -448,6 +521,26 @@ static void remove_range(range_t **ranges, char *lo)
     }
 }
 
+/*
+ * usable_size - Return the usable size the package reports for block
+ *     p, or 0 if it is smaller than the size the block was asked for.
+ *     The caller adds the whole usable extent to the range list, so
+ *     slack that overlaps another block is caught as well.
+ */
+static int usable_size(char *p, int size, int tracenum, int opnum)
+{
+    size_t usable = usable_fn(p);
+    char msg[MAXLINE];
+
+    if (usable < (size_t)size) {
+	sprintf(msg, "mm_usable_size (%lu) is less than the request (%d)",
+		(unsigned long)usable, size);
+	malloc_error(tracenum, opnum, msg);
+	return 0;
+    }
+    return (int)usable;
+}
+
 /*
  * clear_ranges - free all of the range records for a trace 
  */
@@ -477,7 +570,10 @@ static trace_t *read_trace(char *tracedir, char *filename)
     trace_t *trace;
     char type[MAXLINE];
     char path[MAXLINE];
-    unsigned index, size;
+    char flags[MAXLINE];
+    unsigned index, size, align, count;
+    int near;
+    char *c;
     unsigned max_index = 0;
     unsigned op_index;
 
@@ -518,6 +614,7 @@ static trace_t *read_trace(char *tracedir, char *filename)
     /* read every request line in the trace file */
     index = 0;
     op_index = 0;
+    trace->num_requests = 0;
     while (fscanf(tracefile, "%s", type) != EOF) {
 	switch(type[0]) {
 	case 'a':
@@ -534,18 +631,61 @@ static trace_t *read_trace(char *tracedir, char *filename)
 	    trace->ops[op_index].size = size;
 	    max_index = (index > max_index) ? index : max_index;
 	    break;
+	case 'm':
+	    fscanf(tracefile, "%u %u %u", &index, &align, &size);
+	    trace->ops[op_index].type = MEMALIGN;
+	    trace->ops[op_index].index = index;
+	    trace->ops[op_index].size = size;
+	    trace->ops[op_index].align = align;
+	    max_index = (index > max_index) ? index : max_index;
+	    break;
+	case 'h':
+	    fscanf(tracefile, "%u %s %d %u", &index, flags, &near, &size);
+	    trace->ops[op_index].type = ALLOC_FLAGS;
+	    trace->ops[op_index].index = index;
+	    trace->ops[op_index].size = size;
+	    trace->ops[op_index].flags = 0;
+	    for (c = flags; *c != '\0'; c++) {
+		if (*c == 's')
+		    trace->ops[op_index].flags |= MALLOC_SHORT;
+		else if (*c == 'l')
+		    trace->ops[op_index].flags |= MALLOC_LONG;
+		else if (*c == 'z')
+		    trace->ops[op_index].flags |= MALLOC_ZERO;
+		else if (*c == 'n')
+		    trace->ops[op_index].flags |= MALLOC_NEAR;
+	    }
+	    trace->ops[op_index].near = near;
+	    max_index = (index > max_index) ? index : max_index;
+	    break;
 	case 'f':
 	    fscanf(tracefile, "%ud", &index);
 	    trace->ops[op_index].type = FREE;
 	    trace->ops[op_index].index = index;
 	    break;
+	case 'A':
+	    fscanf(tracefile, "%u %u %u", &index, &count, &size);
+	    trace->ops[op_index].type = BATCH_ALLOC;
+	    trace->ops[op_index].index = index;
+	    trace->ops[op_index].count = count;
+	    trace->ops[op_index].size = size;
+	    max_index = (index + count - 1 > max_index) ? index + count - 1 : max_index;
+	    trace->num_requests += count - 1;
+	    break;
+	case 'F':
+	    fscanf(tracefile, "%u %u", &index, &count);
+	    trace->ops[op_index].type = BATCH_FREE;
+	    trace->ops[op_index].index = index;
+	    trace->ops[op_index].count = count;
+	    trace->num_requests += count - 1;
+	    break;
 	default:
 	    printf("Bogus type character (%c) in tracefile %s\n", 
 		   type[0], path);
 	    exit(1);
 	}
 	op_index++;
-	
+	trace->num_requests++;
     }
     fclose(tracefile);
     assert(max_index == trace->num_ids - 1);
@@ -571,6 +711,46 @@ void free_trace(trace_t *trace)
  * and throughput of the libc and mm malloc packages.
  **********************************************************************/
 
+/*
+ * eval_mm - Evaluate the mm package on every trace: check it for
+ *     correctness, then measure its space utilization and throughput.
+ */
+static void eval_mm(int num_tracefiles, char **tracefiles, stats_t *stats)
+{
+    int i;
+    trace_t *trace;
+    range_t *ranges = NULL;
+    speed_t speed_params;
+
+    for (i=0; i < num_tracefiles; i++) {
+	trace = read_trace(tracedir, tracefiles[i]);
+	stats[i].ops = trace->num_requests;
+	if (verbose > 1)
+	    printf("Checking mm_malloc for correctness, ");
+	stats[i].valid = eval_mm_valid(trace, i, &ranges);
+	if (stats[i].valid) {
+	    if (verbose > 1)
+		printf("efficiency, ");
+	    stats[i].util = eval_mm_util(trace, i, &ranges);
+	    stats[i].peak = mem_heap_peak();
+	    stats[i].heap = mem_heapsize();
+	    speed_params.trace = trace;
+	    speed_params.ranges = ranges;
+	    if (verbose > 1) {
+		printf("and performance.\n");
+		mm_report();	/* engine counters for the util run */
+		if (near_stats.named > 0)
+		    printf("near: %d named, %d in the same page, %d within a cache line\n",
+			   near_stats.named, near_stats.page, near_stats.line);
+		if (tcache)
+		    tc_report();
+	    }
+	    stats[i].secs = fsecs(eval_mm_speed, &speed_params);
+	}
+	free_trace(trace);
+    }
+}
+
 /*
  * eval_mm_valid - Check the mm malloc package for correctness
  */
@@ -580,6 +760,8 @@ static int eval_mm_valid(trace_t *trace, int tracenum, range_t **ranges)
     int index;
     int size;
     int oldsize;
+    int usable;
+    int count;
     char *newp;
     char *oldp;
     char *p;
@@ -589,7 +771,7 @@ static int eval_mm_valid(trace_t *trace, int tracenum, range_t **ranges)
     clear_ranges(ranges);
 
     /* Call the mm package's init function */
-    if (mm_init() < 0) {
+    if (init_fn() < 0) {
 	malloc_error(tracenum, 0, "mm_init failed.");
 	return 0;
     }
@@ -604,7 +786,7 @@ static int eval_mm_valid(trace_t *trace, int tracenum, range_t **ranges)
         case ALLOC: /* mm_malloc */
 
 	    /* Call the student's malloc */
-	    if ((p = mm_malloc(size)) == NULL) {
+	    if ((p = malloc_fn(size)) == NULL) {
 		malloc_error(tracenum, i, "mm_malloc failed.");
 		return 0;
 	    }
@@ -614,7 +796,8 @@ static int eval_mm_valid(trace_t *trace, int tracenum, range_t **ranges)
 	     * to the range list if OK. The block must be  be aligned properly,
 	     * and must not overlap any currently allocated block. 
 	     */ 
-	    if (add_range(ranges, p, size, tracenum, i) == 0)
+	    if ((usable = usable_size(p, size, tracenum, i)) == 0 ||
+		add_range(ranges, p, usable, tracenum, i) == 0)
 		return 0;
 	    
 	    /* ADDED: cgw
@@ -629,11 +812,67 @@ static int eval_mm_valid(trace_t *trace, int tracenum, range_t **ranges)
 	    trace->block_sizes[index] = size;
 	    break;
 
+        case MEMALIGN: /* mm_memalign */
+
+	    /* Call the student's memalign */
+	    if ((p = memalign_fn(trace->ops[i].align, size)) == NULL) {
+		malloc_error(tracenum, i, "mm_memalign failed.");
+		return 0;
+	    }
+
+	    /* The payload must land on the requested alignment */
+	    if (((size_t)p % trace->ops[i].align) != 0) {
+		sprintf(msg, "Payload address (%p) not aligned to %d bytes",
+			p, trace->ops[i].align);
+		malloc_error(tracenum, i, msg);
+		return 0;
+	    }
+	    if ((usable = usable_size(p, size, tracenum, i)) == 0 ||
+		add_range(ranges, p, usable, tracenum, i) == 0)
+		return 0;
+	    memset(p, index & 0xFF, size);
+
+	    /* Remember region */
+	    trace->blocks[index] = p;
+	    trace->block_sizes[index] = size;
+	    break;
+
+        case ALLOC_FLAGS: /* mm_malloc_flags */
+
+	    /* Call the student's malloc with the op's hints */
+	    if ((p = malloc_flags_fn(size, trace->ops[i].flags,
+				     NEAR_OF(trace, i))) == NULL) {
+		malloc_error(tracenum, i, "mm_malloc_flags failed.");
+		return 0;
+	    }
+	    if ((usable = usable_size(p, size, tracenum, i)) == 0 ||
+		add_range(ranges, p, usable, tracenum, i) == 0)
+		return 0;
+
+	    /* 
+	     * Freed blocks were filled with their id's low byte, so a
+	     * recycled block that skipped the clearing shows up here.
+	     */
+	    if (trace->ops[i].flags & MALLOC_ZERO) {
+		for (j = 0; j < size; j++) {
+		    if (p[j] != 0) {
+			malloc_error(tracenum, i, "mm_malloc_flags did not zero the payload");
+			return 0;
+		    }
+		}
+	    }
+	    memset(p, index & 0xFF, size);
+
+	    /* Remember region */
+	    trace->blocks[index] = p;
+	    trace->block_sizes[index] = size;
+	    break;
+
         case REALLOC: /* mm_realloc */
 	    
 	    /* Call the student's realloc */
 	    oldp = trace->blocks[index];
-	    if ((newp = mm_realloc(oldp, size)) == NULL) {
+	    if ((newp = realloc_fn(oldp, size)) == NULL) {
 		malloc_error(tracenum, i, "mm_realloc failed.");
 		return 0;
 	    }
@@ -642,7 +881,8 @@ static int eval_mm_valid(trace_t *trace, int tracenum, range_t **ranges)
 	    remove_range(ranges, oldp);
 	    
 	    /* Check new block for correctness and add it to range list */
-	    if (add_range(ranges, newp, size, tracenum, i) == 0)
+	    if ((usable = usable_size(newp, size, tracenum, i)) == 0 ||
+		add_range(ranges, newp, usable, tracenum, i) == 0)
 		return 0;
 	    
 	    /* ADDED: cgw
@@ -671,7 +911,44 @@ static int eval_mm_valid(trace_t *trace, int tracenum, range_t **ranges)
 	    /* Remove region from list and call student's free function */
 	    p = trace->blocks[index];
 	    remove_range(ranges, p);
-	    mm_free(p);
+	    if (!sized_free)
+		free_fn(p);
+	    else {
+		/* The size handed back must be one the block can hold */
+		if (usable_size(p, trace->block_sizes[index], tracenum, i) == 0)
+		    return 0;
+		free_sized_fn(p, trace->block_sizes[index]);
+	    }
+	    break;
+
+        case BATCH_ALLOC: /* mm_malloc_batch */
+
+	    /* Call the student's batch malloc; it must return every block */
+	    count = trace->ops[i].count;
+	    if (malloc_batch_fn(size, count, (void **)&trace->blocks[index])
+		!= (size_t)count) {
+		malloc_error(tracenum, i, "mm_malloc_batch failed.");
+		return 0;
+	    }
+
+	    /* Check, fill and remember each block like a single malloc */
+	    for (j = 0; j < count; j++) {
+		p = trace->blocks[index + j];
+		if ((usable = usable_size(p, size, tracenum, i)) == 0 ||
+		    add_range(ranges, p, usable, tracenum, i) == 0)
+		    return 0;
+		memset(p, (index + j) & 0xFF, size);
+		trace->block_sizes[index + j] = size;
+	    }
+	    break;
+
+        case BATCH_FREE: /* mm_free_batch */
+
+	    /* Remove the regions from the list and free them in one call */
+	    count = trace->ops[i].count;
+	    for (j = 0; j < count; j++)
+		remove_range(ranges, trace->blocks[index + j]);
+	    free_batch_fn((void **)&trace->blocks[index], count);
 	    break;
 
 	default:
@@ -689,35 +966,39 @@ static int eval_mm_valid(trace_t *trace, int tracenum, range_t **ranges)
  *   The idea is to remember the high water mark "hwm" of the heap for 
  *   an optimal allocator, i.e., no gaps and no internal fragmentation.
  *   Utilization is the ratio hwm/heapsize, where heapsize is the 
- *   size of the heap in bytes after running the student's malloc 
- *   package on the trace. Note that our implementation of mem_sbrk() 
- *   doesn't allow the students to decrement the brk pointer, so brk
- *   is always the high water mark of the heap. 
+ *   peak size of the heap in bytes while running the student's malloc 
+ *   package on the trace. mem_sbrk() lets the package decrement the 
+ *   brk pointer, so the peak comes from mem_heap_peak() rather than 
+ *   the final brk; the caller reads the final size with mem_heapsize().
  *   
  */
 static double eval_mm_util(trace_t *trace, int tracenum, range_t **ranges)
 {   
-    int i;
-    int index;
+    int i, j;
+    int index, count;
     int size, newsize, oldsize;
     int max_total_size = 0;
     int total_size = 0;
     char *p;
     char *newp, *oldp;
+    char *near;
 
     /* initialize the heap and the mm malloc package */
     mem_reset_brk();
-    if (mm_init() < 0)
+    if (init_fn() < 0)
 	app_error("mm_init failed in eval_mm_util");
+    memset(&near_stats, 0, sizeof(near_stats));
 
     for (i = 0;  i < trace->num_ops;  i++) {
         switch (trace->ops[i].type) {
 
         case ALLOC: /* mm_alloc */
+        case MEMALIGN: /* mm_memalign */
 	    index = trace->ops[i].index;
 	    size = trace->ops[i].size;
 
-	    if ((p = mm_malloc(size)) == NULL) 
+	    if ((p = trace->ops[i].type == MEMALIGN ?
+		 memalign_fn(trace->ops[i].align, size) : malloc_fn(size)) == NULL) 
 		app_error("mm_malloc failed in eval_mm_util");
 	    
 	    /* Remember region and size */
@@ -733,13 +1014,43 @@ static double eval_mm_util(trace_t *trace, int tracenum, range_t **ranges)
 		total_size : max_total_size;
 	    break;
 
+        case ALLOC_FLAGS: /* mm_malloc_flags */
+	    index = trace->ops[i].index;
+	    size = trace->ops[i].size;
+	    if ((p = malloc_flags_fn(size, trace->ops[i].flags,
+				     NEAR_OF(trace, i))) == NULL)
+		app_error("mm_malloc_flags failed in eval_mm_util");
+
+	    /* 
+	     * How close did the block land to its named neighbour? Counted
+	     * with or without MALLOC_NEAR, so a trace with the hint stripped
+	     * gives the baseline.
+	     */
+	    if (trace->ops[i].near >= 0) {
+		near = trace->blocks[trace->ops[i].near];
+		j = trace->block_sizes[trace->ops[i].near];
+		near_stats.named++;
+		if ((size_t)p / NEAR_PAGE == (size_t)near / NEAR_PAGE)
+		    near_stats.page++;
+		if ((size_t)p / NEAR_LINE <= ((size_t)near + j - 1) / NEAR_LINE + 1 &&
+		    (size_t)near / NEAR_LINE <= ((size_t)p + size - 1) / NEAR_LINE + 1)
+		    near_stats.line++;
+	    }
+
+	    trace->blocks[index] = p;
+	    trace->block_sizes[index] = size;
+	    total_size += size;
+	    max_total_size = (total_size > max_total_size) ?
+		total_size : max_total_size;
+	    break;
+
 	case REALLOC: /* mm_realloc */
 	    index = trace->ops[i].index;
 	    newsize = trace->ops[i].size;
 	    oldsize = trace->block_sizes[index];
 
 	    oldp = trace->blocks[index];
-	    if ((newp = mm_realloc(oldp,newsize)) == NULL)
+	    if ((newp = realloc_fn(oldp,newsize)) == NULL)
 		app_error("mm_realloc failed in eval_mm_util");
 
 	    /* Remember region and size */
@@ -760,7 +1071,10 @@ static double eval_mm_util(trace_t *trace, int tracenum, range_t **ranges)
 	    size = trace->block_sizes[index];
 	    p = trace->blocks[index];
 	    
-	    mm_free(p);
+	    if (sized_free)
+		free_sized_fn(p, size);
+	    else
+		free_fn(p);
 	    
 	    /* Keep track of current total size
 	     * of all allocated blocks */
@@ -768,13 +1082,38 @@ static double eval_mm_util(trace_t *trace, int tracenum, range_t **ranges)
 	    
 	    break;
 
+        case BATCH_ALLOC: /* mm_malloc_batch */
+	    index = trace->ops[i].index;
+	    size = trace->ops[i].size;
+	    count = trace->ops[i].count;
+
+	    if (malloc_batch_fn(size, count, (void **)&trace->blocks[index])
+		!= (size_t)count)
+		app_error("mm_malloc_batch failed in eval_mm_util");
+	    for (j = 0; j < count; j++)
+		trace->block_sizes[index + j] = size;
+
+	    total_size += count * size;
+	    max_total_size = (total_size > max_total_size) ?
+		total_size : max_total_size;
+	    break;
+
+        case BATCH_FREE: /* mm_free_batch */
+	    index = trace->ops[i].index;
+	    count = trace->ops[i].count;
+
+	    for (j = 0; j < count; j++)
+		total_size -= trace->block_sizes[index + j];
+	    free_batch_fn((void **)&trace->blocks[index], count);
+	    break;
+
 	default:
 	    app_error("Nonexistent request type in eval_mm_util");
 
         }
     }
 
-    return ((double)max_total_size / (double)mem_heapsize());
+    return ((double)max_total_size / (double)mem_heap_peak());
 }
 
 
@@ -784,13 +1123,13 @@ static double eval_mm_util(trace_t *trace, int tracenum, range_t **ranges)
  */
 static void eval_mm_speed(void *ptr)
 {
-    int i, index, size, newsize;
+    int i, j, index, size, newsize, count;
     char *p, *newp, *oldp, *block;
     trace_t *trace = ((speed_t *)ptr)->trace;
 
     /* Reset the heap and initialize the mm package */
     mem_reset_brk();
-    if (mm_init() < 0) 
+    if (init_fn() < 0) 
 	app_error("mm_init failed in eval_mm_speed");
 
     /* Interpret each trace request */
@@ -800,24 +1139,64 @@ static void eval_mm_speed(void *ptr)
         case ALLOC: /* mm_malloc */
             index = trace->ops[i].index;
             size = trace->ops[i].size;
-            if ((p = mm_malloc(size)) == NULL)
+            if ((p = malloc_fn(size)) == NULL)
 		app_error("mm_malloc error in eval_mm_speed");
             trace->blocks[index] = p;
+            trace->block_sizes[index] = size;
+            break;
+
+        case MEMALIGN: /* mm_memalign */
+            index = trace->ops[i].index;
+            size = trace->ops[i].size;
+            if ((p = memalign_fn(trace->ops[i].align, size)) == NULL)
+		app_error("mm_memalign error in eval_mm_speed");
+            trace->blocks[index] = p;
+            trace->block_sizes[index] = size;
+            break;
+
+        case ALLOC_FLAGS: /* mm_malloc_flags */
+            index = trace->ops[i].index;
+            size = trace->ops[i].size;
+            if ((p = malloc_flags_fn(size, trace->ops[i].flags,
+				     NEAR_OF(trace, i))) == NULL)
+		app_error("mm_malloc_flags error in eval_mm_speed");
+            trace->blocks[index] = p;
+            trace->block_sizes[index] = size;
             break;
 
 	case REALLOC: /* mm_realloc */
 	    index = trace->ops[i].index;
             newsize = trace->ops[i].size;
 	    oldp = trace->blocks[index];
-            if ((newp = mm_realloc(oldp,newsize)) == NULL)
+            if ((newp = realloc_fn(oldp,newsize)) == NULL)
 		app_error("mm_realloc error in eval_mm_speed");
             trace->blocks[index] = newp;
+            trace->block_sizes[index] = newsize;
             break;
 
         case FREE: /* mm_free */
             index = trace->ops[i].index;
             block = trace->blocks[index];
-            mm_free(block);
+            if (sized_free)
+                free_sized_fn(block, trace->block_sizes[index]);
+            else
+                free_fn(block);
+            break;
+
+        case BATCH_ALLOC: /* mm_malloc_batch */
+            index = trace->ops[i].index;
+            size = trace->ops[i].size;
+            count = trace->ops[i].count;
+            if (malloc_batch_fn(size, count, (void **)&trace->blocks[index])
+		!= (size_t)count)
+		app_error("mm_malloc_batch error in eval_mm_speed");
+            for (j = 0; j < count; j++)
+                trace->block_sizes[index + j] = size;
+            break;
+
+        case BATCH_FREE: /* mm_free_batch */
+            index = trace->ops[i].index;
+            free_batch_fn((void **)&trace->blocks[index], trace->ops[i].count);
             break;
 
 	default:
@@ -833,7 +1212,7 @@ static void eval_mm_speed(void *ptr)
  */
 static int eval_libc_valid(trace_t *trace, int tracenum)
 {
-    int i, newsize;
+    int i, j, newsize;
     char *p, *newp, *oldp;
 
     for (i = 0;  i < trace->num_ops;  i++) {
@@ -847,6 +1226,23 @@ static int eval_libc_valid(trace_t *trace, int tracenum)
 	    trace->blocks[trace->ops[i].index] = p;
 	    break;
 
+        case MEMALIGN: /* posix_memalign */
+	    if (posix_memalign((void **)&p, trace->ops[i].align, trace->ops[i].size) != 0) {
+		malloc_error(tracenum, i, "libc posix_memalign failed");
+		unix_error("System message");
+	    }
+	    trace->blocks[trace->ops[i].index] = p;
+	    break;
+
+        case ALLOC_FLAGS: /* libc takes no hints; calloc for MALLOC_ZERO */
+	    if ((p = (trace->ops[i].flags & MALLOC_ZERO) ?
+		 calloc(1, trace->ops[i].size) : malloc(trace->ops[i].size)) == NULL) {
+		malloc_error(tracenum, i, "libc malloc failed");
+		unix_error("System message");
+	    }
+	    trace->blocks[trace->ops[i].index] = p;
+	    break;
+
 	case REALLOC: /* realloc */
             newsize = trace->ops[i].size;
 	    oldp = trace->blocks[trace->ops[i].index];
@@ -861,6 +1257,21 @@ static int eval_libc_valid(trace_t *trace, int tracenum)
 	    free(trace->blocks[trace->ops[i].index]);
 	    break;
 
+        case BATCH_ALLOC: /* libc has no batch malloc; one malloc per block */
+	    for (j = 0; j < trace->ops[i].count; j++) {
+		if ((p = malloc(trace->ops[i].size)) == NULL) {
+		    malloc_error(tracenum, i, "libc malloc failed");
+		    unix_error("System message");
+		}
+		trace->blocks[trace->ops[i].index + j] = p;
+	    }
+	    break;
+
+        case BATCH_FREE: /* one free per block */
+	    for (j = 0; j < trace->ops[i].count; j++)
+		free(trace->blocks[trace->ops[i].index + j]);
+	    break;
+
 	default:
 	    app_error("invalid operation type  in eval_libc_valid");
 	}
@@ -876,7 +1287,7 @@ static int eval_libc_valid(trace_t *trace, int tracenum)
  */
 static void eval_libc_speed(void *ptr)
 {
-    int i;
+    int i, j;
     int index, size, newsize;
     char *p, *newp, *oldp, *block;
     trace_t *trace = ((speed_t *)ptr)->trace;
@@ -891,6 +1302,23 @@ static void eval_libc_speed(void *ptr)
 	    trace->blocks[index] = p;
 	    break;
 
+        case MEMALIGN: /* posix_memalign */
+	    index = trace->ops[i].index;
+	    size = trace->ops[i].size;
+	    if (posix_memalign((void **)&p, trace->ops[i].align, size) != 0)
+		unix_error("posix_memalign failed in eval_libc_speed");
+	    trace->blocks[index] = p;
+	    break;
+
+        case ALLOC_FLAGS: /* calloc for MALLOC_ZERO, malloc otherwise */
+	    index = trace->ops[i].index;
+	    size = trace->ops[i].size;
+	    if ((p = (trace->ops[i].flags & MALLOC_ZERO) ?
+		 calloc(1, size) : malloc(size)) == NULL)
+		unix_error("malloc failed in eval_libc_speed");
+	    trace->blocks[index] = p;
+	    break;
+
 	case REALLOC: /* realloc */
 	    index = trace->ops[i].index;
 	    newsize = trace->ops[i].size;
@@ -906,6 +1334,22 @@ static void eval_libc_speed(void *ptr)
 	    block = trace->blocks[index];
 	    free(block);
 	    break;
+
+        case BATCH_ALLOC: /* one malloc per block */
+	    index = trace->ops[i].index;
+	    size = trace->ops[i].size;
+	    for (j = 0; j < trace->ops[i].count; j++) {
+		if ((p = malloc(size)) == NULL)
+		    unix_error("malloc failed in eval_libc_speed");
+		trace->blocks[index + j] = p;
+	    }
+	    break;
+
+        case BATCH_FREE: /* one free per block */
+	    index = trace->ops[i].index;
+	    for (j = 0; j < trace->ops[i].count; j++)
+		free(trace->blocks[index + j]);
+	    break;
 	}
     }
 }
@@ -924,49 +1368,61 @@ static void printresults(int n, stats_t *stats)
     double secs = 0;
     double ops = 0;
     double util = 0;
+    double peak = 0;
+    double heap = 0;
 
     /* Print the individual results for each trace */
-    printf("%5s%7s %5s%8s%10s%6s\n", 
-	   "trace", " valid", "util", "ops", "secs", "Kops");
+    printf("%5s%7s %5s%8s%8s%8s%10s%6s\n", 
+	   "trace", " valid", "util", "peakKB", "endKB", "ops", "secs", "Kops");
     for (i=0; i < n; i++) {
 	if (stats[i].valid) {
-	    printf("%2d%10s%5.0f%%%8.0f%10.6f%6.0f\n", 
+	    printf("%2d%10s%5.0f%%%8.0f%8.0f%8.0f%10.6f%6.0f\n", 
 		   i,
 		   "yes",
 		   stats[i].util*100.0,
+		   stats[i].peak/1024.0,
+		   stats[i].heap/1024.0,
 		   stats[i].ops,
 		   stats[i].secs,
 		   (stats[i].ops/1e3)/stats[i].secs);
 	    secs += stats[i].secs;
 	    ops += stats[i].ops;
 	    util += stats[i].util;
+	    peak += stats[i].peak;
+	    heap += stats[i].heap;
 	}
 	else {
-	    printf("%2d%10s%6s%8s%10s%6s\n", 
+	    printf("%2d%10s%6s%8s%8s%8s%10s%6s\n", 
 		   i,
 		   "no",
 		   "-",
 		   "-",
 		   "-",
+		   "-",
+		   "-",
 		   "-");
 	}
     }
 
     /* Print the aggregate results for the set of traces */
     if (errors == 0) {
-	printf("%12s%5.0f%%%8.0f%10.6f%6.0f\n", 
+	printf("%12s%5.0f%%%8.0f%8.0f%8.0f%10.6f%6.0f\n", 
 	       "Total       ",
 	       (util/n)*100.0,
+	       peak/1024.0,
+	       heap/1024.0,
 	       ops, 
 	       secs,
 	       (ops/1e3)/secs);
     }
     else {
-	printf("%12s%6s%8s%10s%6s\n", 
+	printf("%12s%6s%8s%8s%8s%10s%6s\n", 
 	       "Total       ",
 	       "-", 
 	       "-", 
 	       "-", 
+	       "-", 
+	       "-", 
 	       "-");
     }
 
@@ -999,18 +1455,87 @@ void malloc_error(int tracenum, int opnum, char *msg)
     printf("ERROR [trace %d, line %d]: %s\n", tracenum, LINENUM(opnum), msg);
 }
 
+/*
+ * printcompare - Print the utilization and throughput of two runs of
+ *     the mm package side by side, trace by trace, with the same totals
+ *     as printresults.
+ */
+static void printcompare(int n, stats_t *first, stats_t *next)
+{
+    int i;
+    double secs[2] = {0, 0};
+    double ops[2] = {0, 0};
+    double util[2] = {0, 0};
+    stats_t *run;
+    int k;
+
+    printf("%5s%8s%8s%8s%8s\n", "trace", "util", "util", "Kops", "Kops");
+    printf("%5s%8s%8s%8s%8s\n", "", "first", "next", "first", "next");
+    for (i=0; i < n; i++) {
+	if (!first[i].valid || !next[i].valid) {
+	    printf("%2d%11s%8s%8s%8s\n", i, "-", "-", "-", "-");
+	    continue;
+	}
+	printf("%2d%10.0f%%%7.0f%%%8.0f%8.0f\n",
+	       i,
+	       first[i].util*100.0,
+	       next[i].util*100.0,
+	       (first[i].ops/1e3)/first[i].secs,
+	       (next[i].ops/1e3)/next[i].secs);
+	for (k = 0; k < 2; k++) {
+	    run = k ? next : first;
+	    secs[k] += run[i].secs;
+	    ops[k] += run[i].ops;
+	    util[k] += run[i].util;
+	}
+    }
+    if (errors == 0)
+	printf("%5s%7.0f%%%7.0f%%%8.0f%8.0f\n",
+	       "Total",
+	       (util[0]/n)*100.0,
+	       (util[1]/n)*100.0,
+	       (ops[0]/1e3)/secs[0],
+	       (ops[1]/1e3)/secs[1]);
+}
+
+/*
+ * set_place - Apply a -p placement rule: a comma-separated list of
+ *     increasing block sizes. Blocks of at least the first size are
+ *     carved from the high end of a free block, and each further size
+ *     switches the end again, e.g. "512" or "64,4096". "0" carves
+ *     every block from the low end.
+ */
+static void set_place(char *spec)
+{
+    int end = PLACE_HIGH;
+    char *s;
+
+    mm_set_place(0, PLACE_LOW);
+    for (s = strtok(spec, ","); s != NULL; s = strtok(NULL, ",")) {
+	if (atoi(s) > 0)
+	    mm_set_place(atoi(s), end);
+	end = !end;
+    }
+}
+
 /* 
  * usage - Explain the command line arguments
  */
 static void usage(void) 
 {
-    fprintf(stderr, "Usage: mdriver [-hvVal] [-f <file>] [-t <dir>]\n");
+    fprintf(stderr, "Usage: mdriver [-hvValns] [-f <file>] [-t <dir>] [-c <bytes>] [-p <sizes>]\n");
     fprintf(stderr, "Options\n");
     fprintf(stderr, "\t-a         Don't check the team structure.\n");
+    fprintf(stderr, "\t-c <bytes> Run the mm package behind the thread-local cache,\n");
+    fprintf(stderr, "\t           caching at most <bytes> per thread.\n");
     fprintf(stderr, "\t-f <file>  Use <file> as the trace file.\n");
     fprintf(stderr, "\t-g         Generate summary info for autograder.\n");
     fprintf(stderr, "\t-h         Print this message.\n");
     fprintf(stderr, "\t-l         Run libc malloc as well.\n");
+    fprintf(stderr, "\t-n         Run the mm package with next fit as well, and compare.\n");
+    fprintf(stderr, "\t-p <sizes> Carve blocks of at least <sizes> (comma-separated,\n");
+    fprintf(stderr, "\t           alternating) from the high end of free blocks.\n");
+    fprintf(stderr, "\t-s         Free through mm_free_sized with each block's request size.\n");
     fprintf(stderr, "\t-t <dir>   Directory to find default traces.\n");
     fprintf(stderr, "\t-v         Print per-trace performance breakdowns.\n");
     fprintf(stderr, "\t-V         Print additional debug info.\n");
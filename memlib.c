@@ -3,6 +3,9 @@
  *            allows us to interleave calls from the student's malloc package 
  *            with the system's malloc package in libc.
  */
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE         /* mremap */
+#endif
 #include <stdio.h>
 #include <stdlib.h>
 #include <assert.h>
@@ -10,6 +13,7 @@
 #include <sys/mman.h>
 #include <string.h>
 #include <errno.h>
+#include <pthread.h>
 
 #include "memlib.h"
 #include "config.h"
@@ -17,14 +21,52 @@
 /*
  * memlib이 관리하는 mem은 메모리 시스템에 대한 시뮬레이션.
  * mm.c 에서 사용하는 힙에 대한 최대 크기를 malloc으로 할당받아 두고,
- * mm.c 에서 mem_sbrk 를 호출했을 때 mem_brk 의 위치를 조절해서 힙의 크기를 조정해 준다.
- * mm.c 에서 사용하는 힙의 범위는 mem_start_brk ~ mem_brk 이다.
+ * mm.c 에서 mem_sbrk 를 호출했을 때 brk 의 위치를 조절해서 힙의 크기를 조정해 준다.
+ * mm.c 에서 사용하는 힙의 범위는 region 마다 start_brk ~ brk 이다.
+ *
+ * 힙은 서로 겹치지 않는 여러 region 으로 나눌 수 있다. 각 region 은 자기 brk 를 따로 가진다.
+ * brk 는 음수 incr 로 줄일 수도 있다 (start_brk 아래로는 안 된다). heap_peak 는 mem_reset_brk 이후 가장 컸던 힙 크기이다.
+ * region 0 은 원래의 힙으로, 저장 공간의 바닥에서부터 자란다. mem_sbrk / mem_heap_lo / mem_heap_hi 는 region 0 을 뜻한다.
+ * mem_region_new 는 저장 공간의 꼭대기에서부터 아래로 고정 크기 region 을 떼어 주고, 그만큼 region 0 의 최대 크기가 줄어든다.
+ *
+ *   mem_store                                                                  mem_store + MAX_HEAP
+ *   |  region 0 -->            |          ...      | region 2     | region 1     |
+ *                              ^ regions[0].max_addr = regions[N-1].start_brk
+ *
+ * 큰 블록을 위한 두 번째 저장 공간으로, mem_map 은 mem_store 밖에 페이지 단위 mapping 을 따로 만들어 준다. (실제 mmap)
+ * mem_remap 은 mapping 의 크기를 mremap 으로 바꾸고 (옮겨질 수 있다), mem_unmap 은 돌려준다.
+ * mapping 의 바이트 수도 mem_heapsize 와 heap_peak 에 들어간다. mem_reset_brk 는 남은 mapping 을 모두 해제한다.
+ *
+ * 여러 스레드가 서로 다른 region 을 동시에 키울 수 있도록 (mm-arena.c), region 표와 brk, mapping 표, heap_peak 는 mem_lock 으로 지킨다.
+ * mem_region_new 는 region 0 의 brk 와 max_addr 를 보고, heap_peak 는 모든 region 의 brk 를 더해서 구하기 때문이다.
+ * mem_init / mem_deinit / mem_reset_brk 와 mem_heapsize 는 다른 스레드가 힙을 쓰지 않을 때만 부른다.
 */
 
+/* a disjoint piece of the simulated heap with its own brk */
+typedef struct {
+    char *start_brk;    /* points to first byte of region */
+    char *brk;          /* points to last byte of region + 1 */
+    char *max_addr;     /* largest legal region address + 1 */
+} region_t;
+
+/* a page-granular mapping outside mem_store */
+typedef struct {
+    char *start;        /* first byte of the mapping */
+    size_t size;        /* bytes, a multiple of the page size */
+} mapping_t;
+
 /* private variables */
-static char *mem_start_brk;  /* points to first byte of heap */
-static char *mem_brk;        /* points to last byte of heap */
-static char *mem_max_addr;   /* largest legal heap address */ 
+static char *mem_store;                     /* storage for all regions */
+static region_t regions[MAX_REGIONS];
+static int num_regions;                     /* regions[0 .. num_regions-1] are in use */
+static size_t heap_peak;                    /* largest mem_heapsize() since mem_reset_brk */
+static mapping_t *mappings;                 /* live mappings, in no particular order */
+static int num_mappings, max_mappings;
+static size_t mapped_bytes;                 /* sum of mappings[].size */
+static pthread_mutex_t mem_lock = PTHREAD_MUTEX_INITIALIZER;  /* guards everything above but mem_store */
+
+static int find_mapping(void *p);
+static void update_peak(void);
 
 /* 
  * mem_init - initialize the memory system model
@@ -32,13 +74,12 @@ static char *mem_max_addr;   /* largest legal heap address */
 void mem_init(void)
 {
     /* allocate the storage we will use to model the available VM */
-    if ((mem_start_brk = (char *)malloc(MAX_HEAP)) == NULL) {
+    if ((mem_store = (char *)malloc(MAX_HEAP)) == NULL) {
 	fprintf(stderr, "mem_init_vm: malloc error\n");
 	exit(1);
     }
 
-    mem_max_addr = mem_start_brk + MAX_HEAP;  /* max legal heap address */
-    mem_brk = mem_start_brk;                  /* heap is empty initially */
+    mem_reset_brk();
 }
 
 /* 
@@ -46,33 +87,34 @@ void mem_init(void)
  */
 void mem_deinit(void)
 {
-    free(mem_start_brk);
+    mem_reset_brk();
+    free(mem_store);
+    free(mappings);
 }
 
 /*
- * mem_reset_brk - reset the simulated brk pointer to make an empty heap
+ * mem_reset_brk - reset the simulated brk pointer to make an empty heap.
+ *    Every region but region 0 and every mapping is given back.
  */
 void mem_reset_brk()
 {
-    mem_brk = mem_start_brk;
+    while (num_mappings > 0)
+	mem_unmap(mappings[num_mappings - 1].start);
+    num_regions = 1;
+    regions[0].start_brk = mem_store;
+    regions[0].brk = mem_store;             /* heap is empty initially */
+    regions[0].max_addr = mem_store + MAX_HEAP;
+    heap_peak = 0;
 }
 
 /* 
  * mem_sbrk - simple model of the sbrk function. Extends the heap 
- *    by incr bytes and returns the start address of the new area. In
- *    this model, the heap cannot be shrunk.
+ *    by incr bytes and returns the start address of the new area. A
+ *    negative incr shrinks the heap and returns the old brk.
  */
 void *mem_sbrk(int incr) 
 {
-    char *old_brk = mem_brk;
-
-    if ( (incr < 0) || ((mem_brk + incr) > mem_max_addr)) {
-	errno = ENOMEM;
-	fprintf(stderr, "ERROR: mem_sbrk failed. Ran out of memory...\n");
-	return (void *)-1;
-    }
-    mem_brk += incr;
-    return (void *)old_brk;
+    return mem_region_sbrk(0, incr);
 }
 
 /*
@@ -80,7 +122,7 @@ void *mem_sbrk(int incr)
  */
 void *mem_heap_lo()
 {
-    return (void *)mem_start_brk;
+    return (void *)regions[0].start_brk;
 }
 
 /* 
@@ -88,15 +130,33 @@ void *mem_heap_lo()
  */
 void *mem_heap_hi()
 {
-    return (void *)(mem_brk - 1);
+    return (void *)(regions[0].brk - 1);
 }
 
 /*
- * mem_heapsize() - returns the heap size in bytes
+ * mem_heapsize() - returns the heap size in bytes, summed over all regions and mappings
  */
 size_t mem_heapsize() 
 {
-    return (size_t)(mem_brk - mem_start_brk);
+    size_t size = mapped_bytes;
+    int i;
+
+    for (i = 0; i < num_regions; i++)
+	size += (size_t)(regions[i].brk - regions[i].start_brk);
+    return size;
+}
+
+/*
+ * mem_heap_peak() - returns the largest mem_heapsize() since mem_reset_brk
+ */
+size_t mem_heap_peak()
+{
+    size_t peak;
+
+    pthread_mutex_lock(&mem_lock);
+    peak = heap_peak;
+    pthread_mutex_unlock(&mem_lock);
+    return peak;
 }
 
 /*
@@ -106,3 +166,233 @@ size_t mem_pagesize()
 {
     return (size_t)getpagesize();
 }
+
+/*
+ * mem_region_new - carve a new empty region that can grow to maxsize bytes
+ *    off the top of the storage. The region starts on a page boundary.
+ *    Returns the region id, or -1 if there is no room left above region 0's brk.
+ */
+int mem_region_new(size_t maxsize)
+{
+    region_t *r;
+    char *start;
+
+    int region;
+
+    maxsize = (maxsize + mem_pagesize() - 1) & ~(mem_pagesize() - 1);
+    pthread_mutex_lock(&mem_lock);
+    if (num_regions == MAX_REGIONS ||      /* one more page of slack for the alignment */
+	maxsize + mem_pagesize() > (size_t)(regions[0].max_addr - regions[0].brk)) {
+	pthread_mutex_unlock(&mem_lock);
+	errno = ENOMEM;
+	return -1;
+    }
+
+    start = (char *)((size_t)(regions[0].max_addr - maxsize) & ~(mem_pagesize() - 1));
+    regions[0].max_addr = start;
+    r = &regions[num_regions];
+    r->start_brk = start;
+    r->brk = start;
+    r->max_addr = start + maxsize;
+    region = num_regions++;
+    pthread_mutex_unlock(&mem_lock);
+    return region;
+}
+
+/*
+ * mem_region_sbrk - mem_sbrk for one region
+ */
+void *mem_region_sbrk(int region, int incr)
+{
+    region_t *r = &regions[region];
+    char *old_brk;
+
+    pthread_mutex_lock(&mem_lock);
+    old_brk = r->brk;
+    if ((r->brk + incr) < r->start_brk) {
+	pthread_mutex_unlock(&mem_lock);
+	errno = EINVAL;
+	fprintf(stderr, "ERROR: mem_sbrk failed. Cannot shrink below the start of the heap...\n");
+	return (void *)-1;
+    }
+    if ((r->brk + incr) > r->max_addr) {
+	pthread_mutex_unlock(&mem_lock);
+	errno = ENOMEM;
+	fprintf(stderr, "ERROR: mem_sbrk failed. Ran out of memory...\n");
+	return (void *)-1;
+    }
+    r->brk += incr;
+    if (incr > 0)
+	update_peak();
+    pthread_mutex_unlock(&mem_lock);
+    return (void *)old_brk;
+}
+
+/*
+ * mem_region_lo - return address of the first byte of a region
+ */
+void *mem_region_lo(int region)
+{
+    return (void *)regions[region].start_brk;
+}
+
+/*
+ * mem_region_hi - return address of the last byte of a region
+ */
+void *mem_region_hi(int region)
+{
+    char *brk;
+
+    pthread_mutex_lock(&mem_lock);
+    brk = regions[region].brk;
+    pthread_mutex_unlock(&mem_lock);
+    return (void *)(brk - 1);
+}
+
+/*
+ * mem_region_of - return the region whose used part holds address p, or -1
+ */
+int mem_region_of(void *p)
+{
+    int i, region = -1;
+
+    pthread_mutex_lock(&mem_lock);
+    for (i = 0; i < num_regions; i++)
+	if ((char *)p >= regions[i].start_brk && (char *)p < regions[i].brk) {
+	    region = i;
+	    break;
+	}
+    pthread_mutex_unlock(&mem_lock);
+    return region;
+}
+
+/*
+ * mem_map - map size bytes (rounded up to whole pages) outside the regions.
+ *    Returns the page-aligned start, or (void *)-1 on failure like mem_sbrk.
+ */
+void *mem_map(size_t size)
+{
+    mapping_t *m;
+    char *p;
+
+    size = (size + mem_pagesize() - 1) & ~(mem_pagesize() - 1);
+    p = mmap(NULL, size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+    if (p == MAP_FAILED) {
+	fprintf(stderr, "ERROR: mem_map failed. Ran out of memory...\n");
+	return (void *)-1;
+    }
+    pthread_mutex_lock(&mem_lock);
+    if (num_mappings == max_mappings) {
+	int n = max_mappings ? 2 * max_mappings : 64;
+
+	if ((m = (mapping_t *)realloc(mappings, n * sizeof(mapping_t))) == NULL) {
+	    pthread_mutex_unlock(&mem_lock);
+	    munmap(p, size);
+	    errno = ENOMEM;
+	    return (void *)-1;
+	}
+	mappings = m;
+	max_mappings = n;
+    }
+    m = &mappings[num_mappings++];
+    m->start = p;
+    m->size = size;
+    mapped_bytes += size;
+    update_peak();
+    pthread_mutex_unlock(&mem_lock);
+    return (void *)p;
+}
+
+/*
+ * mem_remap - resize the mapping that starts at p to size bytes (rounded up
+ *    to whole pages). The mapping may move; returns its new start, or
+ *    (void *)-1 on failure, in which case the old mapping is untouched.
+ */
+void *mem_remap(void *p, size_t size)
+{
+    int i;
+    char *newp;
+
+    size = (size + mem_pagesize() - 1) & ~(mem_pagesize() - 1);
+    pthread_mutex_lock(&mem_lock);
+    if ((i = find_mapping(p)) < 0) {
+	pthread_mutex_unlock(&mem_lock);
+	errno = EINVAL;
+	return (void *)-1;
+    }
+    newp = mremap(p, mappings[i].size, size, MREMAP_MAYMOVE);
+    if (newp == MAP_FAILED) {
+	pthread_mutex_unlock(&mem_lock);
+	fprintf(stderr, "ERROR: mem_remap failed. Ran out of memory...\n");
+	return (void *)-1;
+    }
+    mapped_bytes = mapped_bytes - mappings[i].size + size;
+    mappings[i].start = newp;
+    mappings[i].size = size;
+    update_peak();
+    pthread_mutex_unlock(&mem_lock);
+    return (void *)newp;
+}
+
+/*
+ * mem_unmap - give back the mapping that starts at p. Returns 0, or -1 if p
+ *    is not the start of a mapping.
+ */
+int mem_unmap(void *p)
+{
+    int i;
+    size_t size;
+
+    pthread_mutex_lock(&mem_lock);
+    if ((i = find_mapping(p)) < 0) {
+	pthread_mutex_unlock(&mem_lock);
+	errno = EINVAL;
+	return -1;
+    }
+    size = mappings[i].size;
+    mapped_bytes -= size;
+    mappings[i] = mappings[--num_mappings];
+    pthread_mutex_unlock(&mem_lock);
+    munmap(p, size);
+    return 0;
+}
+
+/*
+ * mem_mapping_of - return an id of the mapping that holds address p, or -1.
+ *    Ids are only stable until the next mem_unmap.
+ */
+int mem_mapping_of(void *p)
+{
+    int i;
+
+    pthread_mutex_lock(&mem_lock);
+    for (i = num_mappings - 1; i >= 0; i--)
+	if ((char *)p >= mappings[i].start && (char *)p < mappings[i].start + mappings[i].size)
+	    break;
+    pthread_mutex_unlock(&mem_lock);
+    return i;
+}
+
+/*
+ * find_mapping - index of the mapping that starts at p, or -1. Newest first. Called with mem_lock held.
+ */
+static int find_mapping(void *p)
+{
+    int i;
+
+    for (i = num_mappings - 1; i >= 0; i--)
+	if (mappings[i].start == (char *)p)
+	    return i;
+    return -1;
+}
+
+/*
+ * update_peak - raise heap_peak to the current mem_heapsize(). Called with mem_lock held.
+ */
+static void update_peak(void)
+{
+    size_t size = mem_heapsize();
+
+    if (size > heap_peak)
+	heap_peak = size;
+}
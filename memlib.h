@@ -7,5 +7,19 @@ void mem_reset_brk(void);
 void *mem_heap_lo(void);
 void *mem_heap_hi(void);
 size_t mem_heapsize(void);
+size_t mem_heap_peak(void);
 size_t mem_pagesize(void);
 
+/* disjoint regions of the heap; region 0 is the one mem_sbrk grows */
+int mem_region_new(size_t maxsize);
+void *mem_region_sbrk(int region, int incr);
+void *mem_region_lo(int region);
+void *mem_region_hi(int region);
+int mem_region_of(void *p);
+
+/* page-granular mappings outside the regions, for large blocks */
+void *mem_map(size_t size);
+void *mem_remap(void *p, size_t size);
+int mem_unmap(void *p);
+int mem_mapping_of(void *p);
+
@@ -0,0 +1,711 @@
+/*
+ * mm-arena.c - multi-arena explicit free-lists, w/ LIFO order, immediate boundary-tag coalescing, per-arena locking.
+ *
+ * 힙 전체를 lock 하나로 감싸면 코어가 늘어도 할당이 빨라지지 않는다. 그래서 힙을 NUM_ARENAS 개의 arena 로 나눈다.
+ * 각 arena 는 memlib 의 region 하나를 자기 힙으로 쓰고, heap_listp / root / lock 을 arena_t 안에 따로 가진다.
+ *  - arena 0 은 mm_init 이 region 0 (mem_sbrk 로 자라는 원래 힙) 위에 만든다.
+ *  - 나머지 arena 는 처음 배정될 때 mem_region_new 로 ARENA_SIZE 크기의 region 을 받아 만든다.
+ *    memlib 이 region 표와 brk 를 자기 lock 으로 지키므로, 다른 스레드가 arena 0 을 키우는 중에 region 을 받아도 된다.
+ *  - 스레드는 처음 mm_malloc 할 때 round-robin 으로 arena 를 배정받는다.
+ *    배정받은 arena 의 lock 을 trylock 으로 잡지 못하면 (다른 스레드와 경합하면) 다음 arena 로 옮겨 간다.
+ *  - mm_free 는 mem_region_of 로 블록이 속한 region 을 찾아, 그 region 의 arena 에 블록을 돌려준다.
+ *    다른 스레드가 할당한 블록도 그 블록의 arena lock 만 잡으면 된다.
+ *
+ * arena 안의 블록 모양은 mm-explicit.c 와 같다.
+ * 모든 블록은 header를 가지며, 가용 블록만 추가로 footer와 prev free block pointer, next free block pointer를 가진다.
+ * 할당 블록에는 footer가 없다. 대신 header의 PREV_ALLOC 비트에 앞 블록의 할당 여부를 기록한다.
+ * lock 을 잡고 있는 시간을 줄이기 위해 가용 리스트는 주소 순서 대신 LIFO 로 관리한다.
+ * 더블워드 정렬 기준이다. 블록의 최소 크기(바이트) 는 16 bytes 이다.
+ *
+ * NOTE TO STUDENTS: Replace this header comment with your own header
+ * comment that gives a high level description of your solution.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <unistd.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "mm.h"
+#include "memlib.h"
+
+/*********************************************************
+ * NOTE TO STUDENTS: Before you do anything else, please
+ * provide your team information in the following struct.
+ ********************************************************/
+team_t team = {
+    /* Team name */
+    "JUNGLE_W06_TEAM_7",
+    /* First member's full name */
+    "LEE_KANG_WOOK",
+    /* First member's email address */
+    "dlrkddnr0421@daum.net",
+    /* Second member’s full name (leave blank if none) */
+    "",
+    /* Second member’s email address (leave blank if none) */
+    ""
+};
+
+/* Basic constants and macros*/
+
+#define WSIZE       4       /* Word and header/footer size (bytes) */
+#define DSIZE       8       /* Double word size (bytes) */
+#define MINBLKSIZE  16      /* minimum block size with header, free pointers and footer */
+#define CHUNKSIZE  (1<<12)  /* Extend heap by this amout (bytes) */
+#ifndef ALIGNMENT
+#define ALIGNMENT   8       /* double word (8) alignment */
+#endif
+#if ALIGNMENT != 8
+#error "mm-arena.c supports only 8-byte alignment"
+#endif
+
+/* Arena constants */
+#define NUM_ARENAS  4               /* arena 0 on region 0, the others on regions of their own */
+#define ARENA_SIZE  (2*(1<<20))     /* most bytes an arena other than arena 0 may grow to */
+
+#define MAX(x, y) ((x) > (y)? (x) : (y))
+
+/* Pack a size and allocated bits into a word */
+#define PACK(size, alloc)   ((size) | (alloc))
+#define PREV_ALLOC  0x2     /* header bit : previous block is allocated */
+
+/* Read and write a word at address p */
+#define GET(p) (*((unsigned int *)(p)))
+#define PUT(p, val) (*(unsigned int *)(p) = (val))
+
+/* Read the size and allocated fields from address p. (p would be an address of header or footer of block)*/
+#define GET_SIZE(p) (GET(p) & ~0x7)
+#define GET_ALLOC(p) (GET(p) & 0x1)
+#define GET_PREV_ALLOC(p) (GET(p) & PREV_ALLOC)
+#define UINT_CAST(p) ((size_t)p)
+
+/* Set or clear the PREV_ALLOC bit of the header at address p */
+#define SET_PREV_ALLOC(p)   PUT(p, GET(p) | PREV_ALLOC)
+#define CLR_PREV_ALLOC(p)   PUT(p, GET(p) & ~PREV_ALLOC)
+
+/* bp(block pointer) : payload의 시작 주소를 가리키는 포인터이다. 헤더를 가리키지 않는다. */
+/* Given block ptr bp(), compute address of its header and footer */
+#define HDRP(bp)        ((char *)(bp) - WSIZE)
+#define FTRP(bp)        ((char *)(bp) + GET_SIZE(HDRP(bp)) - DSIZE)     // 가용 블록에만 footer가 있다.
+
+/* Given block ptr bp, compute address of next and previous blocks */
+/* PREV_BLKP 는 앞 블록의 footer를 읽으므로, GET_PREV_ALLOC 으로 앞 블록이 가용임을 확인한 뒤에만 쓸 수 있다. */
+#define NEXT_BLKP(bp)   ((char *)(bp) + GET_SIZE(((char *)(bp) - WSIZE)))
+#define PREV_BLKP(bp)   ((char *)(bp) - GET_SIZE(((char *)(bp) - DSIZE)))
+
+/* Given free block ptr bp, compute address of previous and next free blocks */
+#define NEXT_FREE(bp)   ((void *)((char *)bp))
+#define PREV_FREE(bp)   ((void *)((char *)bp + WSIZE))
+
+/* Read and write a free-list link at address p : 32-bit offset from link_base, 0 is NULL */
+#define GET_LINK(p)         ((void *)(GET(p) ? link_base + GET(p) : NULL))
+#define PUT_LINK(p, ptr)    PUT(p, (ptr) ? (unsigned int)((char *)(ptr) - link_base) : 0)
+
+/* rounds up to the nearest multiple of ALIGNMENT */
+#define ALIGN(size) (((size) + (ALIGNMENT-1)) & ~0x7)
+
+/* heap checker */
+#ifdef DEBUG
+# define CHECKHEAP() printf("\n%s : %d\n", __func__,__LINE__); mm_checkheap(__LINE__);
+#endif
+
+/*
+ * arena_t - 예전에 전역 변수였던 힙 상태. 함수들은 모두 arena 를 인자로 받으므로, 서로 다른 arena 는 동시에 쓸 수 있다.
+ */
+typedef struct {
+    pthread_mutex_t lock;   /* guards everything below and the arena's blocks */
+    int region;             /* memlib region the arena grows, -1 if not created yet */
+    char *heap_listp;       /* prologue footer + WSIZE, i.e. the first block */
+    void *root;             /* prologue next / prev words, head of the free list */
+    int mallocs, frees;     /* requests served since mm_init */
+    int contended;          /* times a thread found the lock busy and moved on */
+} arena_t;
+
+/* private variables */
+static arena_t arenas[NUM_ARENAS];
+static char *link_base;                     /* free-list links are offsets from here */
+static pthread_mutex_t arenas_lock = PTHREAD_MUTEX_INITIALIZER;   /* guards arena creation and next_arena */
+static pthread_once_t arenas_once = PTHREAD_ONCE_INIT;  /* the arena locks are initialized once, not per mm_init */
+static int next_arena;                  /* round-robin cursor for thread assignment */
+static unsigned int arena_epoch;        /* bumped by mm_init so threads drop stale assignments */
+static __thread arena_t *thread_arena;
+static __thread unsigned int thread_epoch;
+
+/* private function declarations */
+int mm_init(void);
+static void init_locks(void);
+static int arena_init(arena_t *a, int region);
+static arena_t *assign_arena(arena_t *from);
+static arena_t *lock_arena(void);
+static arena_t *owner_arena(void *bp);
+static void *extend_heap(arena_t *a, size_t words);
+static void *find_fit(arena_t *a, size_t asize);
+static void place(arena_t *a, void *bp, size_t asize);
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset);
+static void place_aligned(arena_t *a, void *bp, char *p, size_t asize);
+static void *coalesce(arena_t *a, void *bp);
+static void update_pointer(void *bp, void *prev, void *next);
+static void insert_free(arena_t *a, void *bp);
+static void remove_free(void *bp);
+static size_t adjust_size(size_t size);
+static void split_block(arena_t *a, void *bp, size_t asize);
+static void mm_checkheap(int lineno);
+
+/*
+ * mm_init - arena 0 을 region 0 위에 만들고, 나머지 arena 는 처음 배정될 때 만들도록 비워 둔다.
+ *         - 다른 스레드가 힙을 쓰고 있지 않을 때만 부른다.
+ */
+int mm_init(void)
+{
+    int i;
+
+    link_base = (char *)mem_heap_lo() - WSIZE;  // 힙 맨 앞 블록도 0 이 아닌 offset 을 갖도록 한 워드 앞에 둔다.
+    pthread_once(&arenas_once, init_locks);
+    for (i = 0; i < NUM_ARENAS; i++)
+        arenas[i].region = -1;
+    next_arena = 0;                     // 처음 배정받는 스레드는 arena 0 을 쓴다.
+    arena_epoch++;
+    return arena_init(&arenas[0], 0);
+}
+
+/*
+ * init_locks - arena lock 들을 만든다. mdriver 는 trace 마다 mm_init 을 다시 부르므로, 이미 만든 mutex 를 또 init 하지 않도록 한 번만 부른다.
+ */
+static void init_locks(void)
+{
+    int i;
+
+    for (i = 0; i < NUM_ARENAS; i++)
+        pthread_mutex_init(&arenas[i].lock, NULL);
+}
+
+/*
+ * arena_init - region 위에 빈 힙을 만든다. 모양은 mm-explicit.c 의 mm_init 과 같다.
+ *
+ * |  PROLOGUE next  |  PROLOGUE prev  |  PROLOGUE footer (4/1)  |  EPILOGUE (0/1 1)  |
+ * ^                                                             ^
+ * root                                                      heap_listp
+ */
+static int arena_init(arena_t *a, int region)
+{
+    char *p;
+
+    if ((p = mem_region_sbrk(region, 4*WSIZE)) == (void *)-1)
+        return -1;
+    PUT(p + 0*WSIZE, 0);                            /* PROLOGUE next */
+    PUT(p + 1*WSIZE, 0);                            /* PROLOGUE prev */
+    PUT(p + 2*WSIZE, PACK(4, 1));                   /* PROLOGUE footer */
+    PUT(p + 3*WSIZE, PACK(0, PREV_ALLOC | 1));      /* EPILOGUE */
+    __atomic_store_n(&a->region, region, __ATOMIC_RELEASE);     // owner_arena 는 lock 없이 읽는다.
+    a->root = p;
+    a->heap_listp = p + 3*WSIZE;
+    a->mallocs = a->frees = a->contended = 0;
+
+    /* Extend the empty heap with a free block of CHUNKSIZE bytes */
+    if (extend_heap(a, CHUNKSIZE/WSIZE) == NULL)
+        return -1;
+    return 0;
+}
+
+/*
+ * assign_arena - from 다음 arena 를 round-robin 으로 골라 스레드에 배정한다. 아직 없는 arena 면 region 을 받아 만든다.
+ *              - region 을 더 받을 수 없으면 이미 있는 arena 중에서 고른다.
+ */
+static arena_t *assign_arena(arena_t *from)
+{
+    arena_t *a;
+    int region;
+
+    pthread_mutex_lock(&arenas_lock);
+    a = &arenas[next_arena];
+    next_arena = (next_arena + 1) % NUM_ARENAS;
+    if (a->region < 0) {
+        if ((region = mem_region_new(ARENA_SIZE)) < 0 || arena_init(a, region) < 0)
+            a = from ? from : &arenas[0];
+    }
+    pthread_mutex_unlock(&arenas_lock);
+
+    thread_arena = a;
+    thread_epoch = arena_epoch;
+    return a;
+}
+
+/*
+ * lock_arena - 스레드의 arena 를 lock 해서 돌려준다.
+ *            - lock 이 바쁘면 다른 스레드와 경합 중이므로, 다음 arena 로 옮겨서 그쪽을 lock 한다.
+ */
+static arena_t *lock_arena(void)
+{
+    arena_t *a = thread_arena;
+
+    if (a == NULL || thread_epoch != arena_epoch)
+        a = assign_arena(NULL);
+    if (pthread_mutex_trylock(&a->lock) == 0)
+        return a;
+
+    __atomic_fetch_add(&a->contended, 1, __ATOMIC_RELAXED);    // lock 을 못 잡았으므로 atomic 으로 센다.
+    a = assign_arena(a);
+    pthread_mutex_lock(&a->lock);
+    return a;
+}
+
+/*
+ * owner_arena - 블록 bp 가 들어 있는 region 의 arena 를 찾는다.
+ */
+static arena_t *owner_arena(void *bp)
+{
+    int region = mem_region_of(bp);
+    int i;
+
+    for (i = 0; i < NUM_ARENAS; i++)
+        if (__atomic_load_n(&arenas[i].region, __ATOMIC_ACQUIRE) == region)
+            return &arenas[i];
+    return NULL;
+}
+
+/*
+ * extend_heap - arena 의 region 을 words 만큼 늘리고, 새 가용 블록을 앞 블록과 합친다.
+ */
+static void *extend_heap(arena_t *a, size_t words)
+{
+    char *bp;
+    size_t size;
+
+    /* Allocate an even number of words to maintain alignment */
+    size = (words % 2) ? (words+1) * WSIZE : words * WSIZE;
+    if ((long)(bp = mem_region_sbrk(a->region, size)) == -1)
+        return NULL;
+    /* Initialize free block header/footer and the epilogue header */
+    PUT(HDRP(bp), PACK(size, GET_PREV_ALLOC(HDRP(bp))));   /* Free block header */
+    PUT(FTRP(bp), GET(HDRP(bp)));           /* Free block footer */
+    PUT(HDRP(NEXT_BLKP(bp)), PACK(0,1));    /* New epilogue header */
+
+    /* Coalesce if the previous block was free block */
+    return coalesce(a, bp);
+}
+
+/*
+ * mm_malloc - 스레드의 arena 에서 size 바이트를 할당한다.
+ */
+void *mm_malloc(size_t size)
+{
+    size_t asize;       /* Adjusted block size for alignment */
+    size_t extendsize;  /* Amount to extend heap if no fit */
+    arena_t *a;
+    char *bp;
+
+    if (size == 0)
+        return NULL;
+
+    asize = adjust_size(size);
+    a = lock_arena();
+    a->mallocs++;
+
+    /* Search the free list for a fit */
+    if ((bp = find_fit(a, asize)) == NULL) {
+        /* No fit found. Get more memory and place the block */
+        extendsize = MAX(asize, CHUNKSIZE);
+        bp = extend_heap(a, extendsize/WSIZE);
+    }
+    if (bp != NULL)
+        place(a, bp, asize);
+
+    pthread_mutex_unlock(&a->lock);
+    return bp;
+}
+
+/*
+ * adjust_size - 요청 size 를 overhead 와 정렬을 포함한 블록 크기로 바꾼다.
+ */
+static size_t adjust_size(size_t size)
+{
+    if (size <= MINBLKSIZE - WSIZE)
+        return MINBLKSIZE;
+    return ALIGN(size + WSIZE);     // 할당 블록에는 footer가 없으므로 헤더 4바이트만 더해준다.
+}
+
+/*
+ * find_fit - find available free block for request. (first fit)
+ */
+static void *find_fit(arena_t *a, size_t asize)
+{
+    for (void *bp = GET_LINK(NEXT_FREE(a->root)); bp != NULL; bp = GET_LINK(NEXT_FREE(bp))) {
+        if (GET_SIZE(HDRP(bp)) >= asize)
+            return bp;
+    }
+    return NULL;
+}
+
+/*
+ * update_pointer - update pointers of bp, prev, next
+ */
+static void update_pointer(void *bp, void *prev, void *next)
+{
+    PUT_LINK(PREV_FREE(bp), prev);
+    PUT_LINK(NEXT_FREE(bp), next);
+    PUT_LINK(NEXT_FREE(prev), bp);
+    if (next)
+        PUT_LINK(PREV_FREE(next), bp);
+}
+
+/*
+ * insert_free - 가용 블록 bp 를 리스트 맨 앞에 넣는다.
+ */
+static void insert_free(arena_t *a, void *bp)
+{
+    update_pointer(bp, a->root, GET_LINK(NEXT_FREE(a->root)));
+}
+
+/*
+ * remove_free - 가용 블록 bp 를 리스트에서 뺀다.
+ */
+static void remove_free(void *bp)
+{
+    PUT(NEXT_FREE(GET_LINK(PREV_FREE(bp))), GET(NEXT_FREE(bp)));
+    if (GET(NEXT_FREE(bp)))
+        PUT(PREV_FREE(GET_LINK(NEXT_FREE(bp))), GET(PREV_FREE(bp)));
+}
+
+/*
+ * place - place allocated block and divide if possible.
+ */
+static void place(arena_t *a, void *bp, size_t asize)
+{
+    remove_free(bp);
+    PUT(HDRP(bp), GET(HDRP(bp)) | 1);
+    SET_PREV_ALLOC(HDRP(NEXT_BLKP(bp)));
+    split_block(a, bp, asize);
+}
+
+/*
+ * split_block - 할당 블록 bp 를 asize 로 줄이고, 남는 부분이 최소 블록 이상이면 가용 블록으로 돌려준다.
+ */
+static void split_block(arena_t *a, void *bp, size_t asize)
+{
+    size_t diff = GET_SIZE(HDRP(bp)) - asize;
+    void *leftover_bp;
+
+    if (diff < MINBLKSIZE)
+        return;
+
+    PUT(HDRP(bp), PACK(asize, GET_PREV_ALLOC(HDRP(bp)) | 1));
+    leftover_bp = NEXT_BLKP(bp);
+    PUT(HDRP(leftover_bp), PACK(diff, PREV_ALLOC));
+    PUT(FTRP(leftover_bp), PACK(diff, PREV_ALLOC));
+    CLR_PREV_ALLOC(HDRP(NEXT_BLKP(leftover_bp)));
+    coalesce(a, leftover_bp);
+}
+
+/*
+ * mm_free - 블록을 그 블록이 속한 arena 에 돌려준다. 할당한 스레드가 아니어도 된다.
+ */
+void mm_free(void *bp)
+{
+    arena_t *a;
+    size_t size;
+
+    if (bp == NULL || (a = owner_arena(bp)) == NULL)
+        return;
+
+    pthread_mutex_lock(&a->lock);       // header 워드는 이웃 블록의 free 가 PREV_ALLOC 을 바꾸므로 lock 을 잡고 읽는다.
+    a->frees++;
+    size = GET_SIZE(HDRP(bp));
+    PUT(HDRP(bp), PACK(size, GET_PREV_ALLOC(HDRP(bp))));
+    PUT(FTRP(bp), GET(HDRP(bp)));
+    CLR_PREV_ALLOC(HDRP(NEXT_BLKP(bp)));
+    coalesce(a, bp);
+    pthread_mutex_unlock(&a->lock);
+}
+
+/*
+ * coalesce - 가용 블록 bp 를 앞, 뒤 가용 블록과 합치고 리스트에 넣는다.
+ */
+static void *coalesce(arena_t *a, void *bp)
+{
+    size_t prev_alloc = GET_PREV_ALLOC(HDRP(bp));
+    size_t next_alloc = GET_ALLOC(HDRP(NEXT_BLKP(bp)));
+    size_t size = GET_SIZE(HDRP(bp));
+
+    if (!next_alloc) {          // 뒤 블록을 흡수한다.
+        void *next_bp = NEXT_BLKP(bp);
+        remove_free(next_bp);
+        size += GET_SIZE(HDRP(next_bp));
+    }
+    if (!prev_alloc) {          // 앞 블록에 흡수된다. 앞 블록은 이미 리스트에 있다.
+        bp = PREV_BLKP(bp);
+        size += GET_SIZE(HDRP(bp));
+        PUT(HDRP(bp), PACK(size, PREV_ALLOC));      // 가용 블록의 앞 블록은 항상 할당 블록이다.
+        PUT(FTRP(bp), PACK(size, PREV_ALLOC));
+        return bp;
+    }
+    PUT(HDRP(bp), PACK(size, PREV_ALLOC));
+    PUT(FTRP(bp), PACK(size, PREV_ALLOC));
+    insert_free(a, bp);
+    return bp;
+}
+
+/*
+ * mm_realloc - 블록의 arena 안에서 줄이거나 뒤 가용 블록을 흡수해서 제자리에서 처리하고,
+ *              안 되면 스레드의 arena 에서 새로 할당해서 복사한다.
+ *            - 새 블록을 할당하는 동안 원래 arena 의 lock 을 쥐고 있지 않도록, 복사 경로는 lock 을 놓은 뒤에 탄다.
+ */
+void *mm_realloc(void *bp, size_t size)
+{
+    void *newptr;
+    void *next_bp;
+    size_t asize, old_size;
+    size_t copySize;
+    arena_t *a;
+
+    if (bp == NULL)
+        return mm_malloc(size);
+    if (size == 0) {
+        mm_free(bp);
+        return NULL;
+    }
+
+    asize = adjust_size(size);
+    a = owner_arena(bp);
+    pthread_mutex_lock(&a->lock);
+    old_size = GET_SIZE(HDRP(bp));
+    next_bp = NEXT_BLKP(bp);
+    if (asize > old_size && !GET_ALLOC(HDRP(next_bp)) && old_size + GET_SIZE(HDRP(next_bp)) >= asize) {
+        remove_free(next_bp);
+        PUT(HDRP(bp), PACK(old_size + GET_SIZE(HDRP(next_bp)), GET_PREV_ALLOC(HDRP(bp)) | 1));
+        SET_PREV_ALLOC(HDRP(NEXT_BLKP(bp)));
+    }
+    if (asize <= GET_SIZE(HDRP(bp))) {
+        split_block(a, bp, asize);
+        pthread_mutex_unlock(&a->lock);
+        return bp;
+    }
+    pthread_mutex_unlock(&a->lock);
+
+    if ((newptr = mm_malloc(size)) == NULL)
+        return NULL;
+    copySize = old_size - WSIZE;
+    if (size < copySize)
+        copySize = size;
+    memcpy(newptr, bp, copySize);
+    mm_free(bp);
+    return newptr;
+}
+
+/*
+ * mm_memalign - payload 가 alignment 의 배수에 오는 블록을 준다. alignment 는 2의 거듭제곱이어야 한다.
+ */
+void *mm_memalign(size_t alignment, size_t size)
+{
+    return mm_memalign_offset(alignment, 0, size);
+}
+
+/*
+ * mm_memalign_offset - payload + offset 이 alignment 의 배수에 오는 블록을 스레드의 arena 에서 준다. offset 은 ALIGNMENT 의 배수이다.
+ *                    - 가용 리스트를 first fit 으로 돌면서 그 자리에 payload 가 들어가는 블록을 찾는다.
+ *                    - 앞 조각은 가용 블록으로 남긴다. 맞는 블록이 없으면 alignment 만큼 여유를 두고 arena 를 늘린다.
+ */
+void *mm_memalign_offset(size_t alignment, size_t offset, size_t size)
+{
+    size_t asize;
+    arena_t *a;
+    char *p = NULL;
+    void *bp;
+
+    if (size == 0 || (alignment & (alignment - 1)) || offset % ALIGNMENT)
+        return NULL;
+    if (alignment <= ALIGNMENT)
+        return mm_malloc(size);
+
+    asize = adjust_size(size);
+    a = lock_arena();
+    a->mallocs++;
+    for (bp = GET_LINK(NEXT_FREE(a->root)); bp != NULL; bp = GET_LINK(NEXT_FREE(bp)))
+        if ((p = aligned_spot(bp, asize, alignment, offset)) != NULL)
+            break;
+
+    if (bp == NULL) {       // 앞 조각 (MINBLKSIZE 이상, alignment 미만) 이 생겨도 asize 가 들어가도록 늘린다.
+        if ((bp = extend_heap(a, MAX(asize + alignment + MINBLKSIZE, CHUNKSIZE)/WSIZE)) != NULL)
+            p = aligned_spot(bp, asize, alignment, offset);
+    }
+    if (p != NULL)
+        place_aligned(a, bp, p, asize);
+
+    pthread_mutex_unlock(&a->lock);
+    return p;
+}
+
+/*
+ * aligned_spot - 가용 블록 bp 안에서 asize 블록의 payload + offset 이 alignment 경계에 오는 가장 앞 자리를 돌려준다. 없으면 NULL.
+ *              - 앞에 남는 조각은 없거나 (p == bp) MINBLKSIZE 이상이어야 가용 블록이 될 수 있다.
+ */
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset)
+{
+    char *p = (char *)((((size_t)bp + offset + alignment - 1) & ~(alignment - 1)) - offset);
+
+    if (p != (char *)bp && p - (char *)bp < MINBLKSIZE)
+        p += alignment;
+    return p + asize <= (char *)bp + GET_SIZE(HDRP(bp)) ? p : NULL;
+}
+
+/*
+ * place_aligned - 가용 블록 bp 의 p 자리에 asize 블록을 할당한다. a->lock 을 잡은 채로 부른다.
+ *               - 앞 조각은 bp 주소에 그대로 남으므로 리스트 위치도 그대로이다. p 부터는 가용 블록으로 만들어 place 에 맡긴다.
+ */
+static void place_aligned(arena_t *a, void *bp, char *p, size_t asize)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    size_t lead = p - (char *)bp;
+
+    if (lead > 0) {
+        PUT(HDRP(bp), PACK(lead, PREV_ALLOC));      // 가용 블록의 앞 블록은 항상 할당 블록이다.
+        PUT(FTRP(bp), GET(HDRP(bp)));
+        PUT(HDRP(p), PACK(size - lead, 0));         // 앞 조각이 가용이므로 PREV_ALLOC 은 끈다.
+        PUT(FTRP(p), GET(HDRP(p)));
+        insert_free(a, p);
+    }
+    place(a, p, asize);
+}
+
+/*
+ * mm_free_sized - this engine does not use the size; same as mm_free.
+ */
+void mm_free_sized(void *ptr, size_t size)
+{
+    mm_free(ptr);
+}
+
+/*
+ * mm_usable_size - payload bytes of the block at ptr, at least the size it was requested with.
+ */
+size_t mm_usable_size(void *ptr)
+{
+    arena_t *a = owner_arena(ptr);
+    size_t size;
+
+    pthread_mutex_lock(&a->lock);       // header 의 PREV_ALLOC 비트는 이웃 블록의 주인도 바꾼다.
+    size = GET_SIZE(HDRP(ptr)) - WSIZE;
+    pthread_mutex_unlock(&a->lock);
+    return size;
+}
+
+/*
+ * mm_malloc_batch - this engine has no batch path; n calls to mm_malloc. Returns how many succeeded.
+ */
+size_t mm_malloc_batch(size_t size, size_t n, void **out)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if ((out[i] = mm_malloc(size)) == NULL)
+            break;
+    return i;
+}
+
+/*
+ * mm_free_batch - this engine has no batch path; n calls to mm_free.
+ */
+void mm_free_batch(void **ptrs, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        mm_free(ptrs[i]);
+}
+
+/*
+ * mm_set_place - this engine has one placement; the rule is ignored.
+ */
+void mm_set_place(size_t size, int end)
+{
+}
+
+/*
+ * mm_set_fit - this engine has one fit policy; the policy is ignored.
+ */
+void mm_set_fit(int policy)
+{
+}
+
+/*
+ * mm_malloc_flags - this engine takes no placement hints; mm_malloc, with the payload cleared for MALLOC_ZERO.
+ */
+void *mm_malloc_flags(size_t size, int flags, void *near)
+{
+    void *p = mm_malloc(size);
+
+    if (p != NULL && (flags & MALLOC_ZERO))
+        memset(p, 0, size);
+    return p;
+}
+
+/*
+ * mm_report - print each arena's region, heap size and traffic since mm_init.
+ */
+void mm_report(void)
+{
+    int i;
+
+    for (i = 0; i < NUM_ARENAS; i++) {
+        arena_t *a = &arenas[i];
+        if (a->region < 0)
+            continue;
+        printf("arena %d: region %d, %u bytes, %d mallocs, %d frees, %d contended\n",
+               i, a->region,
+               (unsigned int)((char *)mem_region_hi(a->region) - (char *)mem_region_lo(a->region) + 1),
+               a->mallocs, a->frees, a->contended);
+    }
+}
+
+/*
+ * mm_checkheap - check heap invariants of every arena. Call with no other thread in the heap.
+ *
+ * #ifdef DEBUG
+ *   CHECKHEAP();
+ * #endif
+ */
+static void mm_checkheap(int lineno)
+{
+    int i;
+
+    for (i = 0; i < NUM_ARENAS; i++) {
+        arena_t *a = &arenas[i];
+        char *heap_lo, *heap_hi, *bp;
+        size_t prev_alloc = PREV_ALLOC;
+        int heap_free_cnt = 0, list_free_cnt = 0;
+        void *free, *next_free;
+
+        if (a->region < 0)
+            continue;
+        heap_lo = mem_region_lo(a->region);
+        heap_hi = (char *)mem_region_hi(a->region) + 1 - WSIZE;
+        assert(heap_lo == a->root);
+        assert(GET(heap_lo + 2*WSIZE) == PACK(WSIZE,1));            // check PROLOGUE footer
+        assert(GET_SIZE(heap_hi) == 0 && GET_ALLOC(heap_hi));       // check epilogue block
+
+        /* block level */
+        for (bp = a->heap_listp + WSIZE; GET_SIZE(HDRP(bp)) > 0; bp = NEXT_BLKP(bp)) {
+            if (!GET_ALLOC(HDRP(bp))) {
+                assert(GET(HDRP(bp)) == GET(FTRP(bp)));     // check header and footer match (free block only)
+                heap_free_cnt++;
+            }
+            assert(GET_PREV_ALLOC(HDRP(bp)) == prev_alloc); // check PREV_ALLOC bit
+            assert(!(UINT_CAST(bp) & 0x7));                 // check if payload area aligned
+            assert(GET_ALLOC(HDRP(bp)) | GET_ALLOC(HDRP(NEXT_BLKP(bp))));   // check contiguous free blocks
+            assert(heap_lo < HDRP(bp) && NEXT_BLKP(bp) - DSIZE < heap_hi);  // check heap bound
+            assert(owner_arena(bp) == a);                   // check region lookup
+            prev_alloc = GET_ALLOC(HDRP(bp)) ? PREV_ALLOC : 0;
+        }
+
+        /* list level check */
+        free = a->root;
+        for (next_free = GET_LINK(NEXT_FREE(free)); next_free != NULL; next_free = GET_LINK(NEXT_FREE(next_free))) {
+            assert(!GET_ALLOC(HDRP(next_free)));
+            assert(GET_LINK(PREV_FREE(next_free)) == free);     // check back link
+            assert(heap_lo < (char *)next_free && (char *)next_free < heap_hi);     // list stays in its arena
+            assert(++list_free_cnt <= heap_free_cnt);               // also stops a cycle
+            free = next_free;
+        }
+        assert(heap_free_cnt == list_free_cnt);     // no stale block left in the list
+    }
+}
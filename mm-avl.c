@@ -0,0 +1,813 @@
+/*
+ * mm-avl.c - best-fit over a size-keyed AVL tree of free blocks, immediate boundary-tag coalescing.
+ *
+ * 가용 블록을 크기를 키로 하는 AVL 트리 (균형 이진 탐색 트리) 에 넣어두고 best-fit 으로 찾는 할당기.
+ * 트리 노드는 mm-explicit.c 의 NEXT_FREE / PREV_FREE 처럼 가용 블록의 payload 안에 들어간다.
+ * 같은 크기의 블록들은 트리 노드 하나에 NEXT_FREE / PREV_FREE 로 체인처럼 매달린다. 그래서 트리의 키는 모두 다르다.
+ * 트리 노드 하나는 5 워드 (next, prev, left, right, height) 가 필요하므로 32 bytes 이상인 블록만 트리에 들어가고,
+ * 16, 24 bytes 블록은 prologue 영역에 헤드가 있는 크기별 리스트에 들어간다. (두 크기 모두 정확히 한 크기만 담으므로 best-fit 이 유지된다)
+ * 탐색, 삽입, 삭제 모두 O(log n) 이다.
+ * 모든 블록은 header와 footer을 가지며, 더블워드 정렬 기준이다. 블록의 최소 크기(바이트) 는 16 bytes 이다.
+ *
+ * NOTE TO STUDENTS: Replace this header comment with your own header
+ * comment that gives a high level description of your solution.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "mm.h"
+#include "memlib.h"
+
+/*********************************************************
+ * NOTE TO STUDENTS: Before you do anything else, please
+ * provide your team information in the following struct.
+ ********************************************************/
+team_t team = {
+    /* Team name */
+    "JUNGLE_W06_TEAM_7",
+    /* First member's full name */
+    "LEE_KANG_WOOK",
+    /* First member's email address */
+    "dlrkddnr0421@daum.net",
+    /* Second member’s full name (leave blank if none) */
+    "",
+    /* Second member’s email address (leave blank if none) */
+    ""
+};
+
+/* Basic constants and macros*/
+
+#define WSIZE       4       /* Word and header/footer size (bytes) */
+#define DSIZE       8       /* Double word size (bytes) */
+#define MINBLKSIZE  16      /* minimum block size with header and footer */
+#define TREEBLKSIZE 32      /* minimum block size which can hold a tree node */
+#define CHUNKSIZE  (1<<12)  /* Extend heap by this amout (bytes) */
+#ifndef ALIGNMENT
+#define ALIGNMENT   8       /* double word (8) alignment */
+#endif
+#if ALIGNMENT != 8
+#error "mm-avl.c supports only 8-byte alignment"
+#endif
+
+#define MAX(x, y) ((x) > (y)? (x) : (y))
+
+/* Pack a size and allocated bit into a word */
+#define PACK(size, alloc)   ((size) | (alloc))
+
+/* Read and write a word at address p */
+#define GET(p) (*((unsigned int *)(p)))
+#define PUT(p, val) (*(unsigned int *)(p) = (val))
+
+/* Read the size and allocated fields from address p. (p would be an address of header or footer of block)*/
+#define GET_SIZE(p) (GET(p) & ~0x7)
+#define GET_ALLOC(p) (GET(p) & 0x1)
+#define UINT_CAST(p) ((size_t)p)
+
+/* bp(block pointer) : payload의 시작 주소를 가리키는 포인터이다. 헤더를 가리키지 않는다. */
+/* Given block ptr bp(), compute address of its header and footer */
+#define HDRP(bp)        ((char *)(bp) - WSIZE)
+#define FTRP(bp)        ((char *)(bp) + GET_SIZE(HDRP(bp)) - DSIZE)
+
+/* Given block ptr bp, compute address of next and previous blocks */
+#define NEXT_BLKP(bp)   ((char *)(bp) + GET_SIZE(((char *)(bp) - WSIZE)))
+#define PREV_BLKP(bp)   ((char *)(bp) - GET_SIZE(((char *)(bp) - DSIZE)))
+
+/* Given free block ptr bp, compute address of previous and next free blocks of the same size */
+#define NEXT_FREE(bp)   ((void *)((char *)bp))
+#define PREV_FREE(bp)   ((void *)((char *)bp + WSIZE))      // 트리 노드 자신은 0, 체인에 매달린 블록은 0 이 아니다.
+
+/* Given tree node bp, compute address of its left child, right child and height */
+#define LEFT(bp)        ((void *)((char *)bp + 2*WSIZE))
+#define RIGHT(bp)       ((void *)((char *)bp + 3*WSIZE))
+#define HEIGHT(bp)      ((void *)((char *)bp + 4*WSIZE))
+
+/* Read and write a free-list or tree link at address p : 32-bit offset from link_base, 0 is NULL */
+// PUT_LINK 의 ptr 자리에는 tree_insert(...) 같은 재귀 호출이 오므로, 한 번만 평가되도록 함수로 인코딩한다.
+#define GET_LINK(p)         ((void *)(GET(p) ? link_base + GET(p) : NULL))
+#define PUT_LINK(p, ptr)    PUT(p, link_offset(ptr))
+
+/* Read fields of a tree node. NULL 노드의 높이는 0 이다. */
+#define GET_LEFT(bp)    GET_LINK(LEFT(bp))
+#define GET_RIGHT(bp)   GET_LINK(RIGHT(bp))
+#define GET_HEIGHT(bp)  ((bp) ? (int)GET(HEIGHT(bp)) : 0)
+
+/* Address of the list heads and the tree root in the prologue area */
+#define SMALL_ROOT(size)    ((void *)(heap_listp - 5*WSIZE + ((size) - MINBLKSIZE) / DSIZE * WSIZE))
+#define TREE_ROOT           ((void *)(heap_listp - 3*WSIZE))
+
+/* rounds up to the nearest multiple of ALIGNMENT */
+#define ALIGN(size) (((size) + (ALIGNMENT-1)) & ~0x7)       // 7을 더해주고 하위 3개의 비트는 0으로 바꿔줌.
+                                                            // 그러면 나보다 높으면서 가장 가까운 8의 배수가 될 수 있다.
+
+/* heap checker */
+#ifdef DEBUG
+# define CHECKHEAP() printf("\n%s : %d\n", __func__,__LINE__); mm_checkheap(__LINE__);
+#endif
+
+/* private variables */
+static char *heap_listp;
+static char *link_base;                     /* free-list links are offsets from here */
+
+/* private function declarations */
+int mm_init(void);
+static void *extend_heap(size_t words);
+static void *find_fit(size_t asize);
+static void place(void *bp, size_t asize);
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset);
+static void place_aligned(void *bp, char *p, size_t asize);
+static void *coalesce(void *bp);
+static void insert_free(void *bp);
+static void remove_free(void *bp);
+static unsigned int link_offset(void *ptr);
+static void update_height(void *node);
+static void *rotate_left(void *node);
+static void *rotate_right(void *node);
+static void *rebalance(void *node);
+static void *tree_insert(void *node, void *bp);
+static void *tree_delete(void *node, void *bp);
+static void *tree_delete_min(void *node, void **min);
+static void *tree_replace(void *node, void *bp, void *new_bp);
+static int check_tree(void *node, size_t lo, size_t hi, int *cnt);
+static void mm_checkheap(int lineno);
+
+/*
+ * mm_init - Initializes the heap like that shown below.
+ -------------------------------------------------------------------------------------------------------------
+ * @                          @                           @                           @  - double word alignment
+ *  _____________ ____________ _____________ _____________ _____________ _____________
+ * |  16 bytes   |  24 bytes  |    TREE     |             |   PROLOGUE  |             |
+ * |  list root  |  list root |    root     |   padding   |    footer   |   EPILOGUE  |
+ * |-------------|------------|-------------|-------------|-------------|-------------|
+ * |      0      |      0     |      0      |      0      |    4 / 1    |    0 / 1    |
+ * |-------------|------------|-------------|-------------|-------------|-------------|
+ *                                                                      ^
+ *                                                                  heap_listp
+ -------------------------------------------------------------------------------------------------------------
+ * 16, 24 bytes 리스트의 헤드는 mm-explicit.c 의 root 처럼 NEXT_FREE 만 가진 더미 블록이다.
+ * TREE root 워드는 트리의 루트 노드를 가리킨다 (비어있으면 0).
+ */
+int mm_init(void)
+{
+    link_base = (char *)mem_heap_lo() - WSIZE;  // 힙 맨 앞 블록도 0 이 아닌 offset 을 갖도록 한 워드 앞에 둔다.
+    /* Create the initial empty heap */
+    if ((heap_listp = mem_sbrk(6*WSIZE)) == (void *)-1)     // 시스템에 요청한 heap공간 할당이 실패했을 때.
+        return -1;
+    PUT(heap_listp + 0*WSIZE, 0);                /* 16 bytes list root */
+    PUT(heap_listp + 1*WSIZE, 0);                /* 24 bytes list root */
+    PUT(heap_listp + 2*WSIZE, 0);                /* TREE root */
+    PUT(heap_listp + 3*WSIZE, 0);                /* padding */
+    PUT(heap_listp + 4*WSIZE, PACK(4, 1));       /* PROLOGUE footer */
+    PUT(heap_listp + 5*WSIZE, PACK(0, 1));       /* EPILOGUE */
+    heap_listp += 5*WSIZE;
+
+    /* Extend the empty heap with a free block of CHUNKSIZE bytes */
+    if (extend_heap(CHUNKSIZE/WSIZE) == NULL)   // 필요한 워드의 개수를 인자로 넘긴다.
+        return -1;
+
+    return 0;
+}
+
+/*
+ * extend_heap은
+ * 1. 힙이 초기화 될 때, 또는
+ * 2.mm_malloc이 적당한 맞춤 fit을 찾지 못했을 때 호출된다.
+ */
+static void *extend_heap(size_t words)
+{
+    char *bp;
+    size_t size;
+
+    /* Allocate an even number of words to maintain alignment */
+    size = (words % 2) ? (words+1) * WSIZE : words * WSIZE;     // 요청 크기를 2워드의 배수로 다시 맞춘다.
+    if ((long)(bp = mem_sbrk(size)) == -1)
+        return NULL;
+    /* Initialize free block header/footer and the epilogue header */
+    PUT(HDRP(bp), PACK(size, 0));           /* Free block header */
+    PUT(FTRP(bp), PACK(size, 0));           /* Free block footer */
+    PUT(HDRP(NEXT_BLKP(bp)), PACK(0,1));    /* New epilogue header */
+
+    /* Coalesce if the previous block was free block */
+    return coalesce(bp);
+}
+
+/*
+ * mm_malloc - size 바이트의 메모리를 할당하고, 해당 블록의 포인터(bp)를 반환.
+ *           - 적절한 크기의 free 블록을 찾지 못한 경우, extend_heap 을 통해 힙을 확장 후 할당.
+ */
+void *mm_malloc(size_t size)
+{
+    size_t asize;       /* Adjusted block size for alignment */
+    size_t extendsize;  /* Amount to extend heap if no fit */
+    char *bp;
+
+    /* 불필요한 요청 무시 */
+    if (size == 0) {
+        return NULL;
+    }
+
+    /* Adjust block size to include overhead and alignment reqs (double word). */
+    if (size <= MINBLKSIZE - DSIZE)
+        asize = MINBLKSIZE;
+    else
+        asize = ALIGN(size) + DSIZE;
+
+    /* Search the free lists and the tree for a fit */
+    if ((bp = find_fit(asize)) != NULL) {
+        place(bp, asize);
+
+        return bp;
+    }
+
+    /* No fit found. Get more memory and place the block */
+    extendsize = MAX(asize, CHUNKSIZE);
+    if ((bp = extend_heap(extendsize/WSIZE)) == NULL)
+        return NULL;
+
+    place(bp, asize);
+
+    return bp;
+}
+
+/*
+ * find_fit - find the smallest free block not smaller than asize (best-fit).
+ *          - 작은 리스트를 먼저 보고, 없으면 트리를 루트부터 내려가며 asize 이상인 가장 작은 노드를 찾는다.
+ *          - 찾은 노드에 같은 크기의 블록이 매달려 있으면 그것을 돌려준다. 트리를 건드리지 않고 O(1) 에 뺄 수 있기 때문.
+*/
+static void *find_fit(size_t asize)
+{
+    void *node;
+    void *fit = NULL;
+
+    if (asize == MINBLKSIZE && GET(NEXT_FREE(SMALL_ROOT(MINBLKSIZE))))
+        return GET_LINK(NEXT_FREE(SMALL_ROOT(MINBLKSIZE)));
+    if (asize <= MINBLKSIZE + DSIZE && GET(NEXT_FREE(SMALL_ROOT(MINBLKSIZE + DSIZE))))
+        return GET_LINK(NEXT_FREE(SMALL_ROOT(MINBLKSIZE + DSIZE)));
+
+    for (node = GET_LINK(TREE_ROOT); node != NULL; ) {
+        if (GET_SIZE(HDRP(node)) >= asize) {
+            fit = node;
+            if (GET_SIZE(HDRP(node)) == asize)
+                break;
+            node = GET_LEFT(node);
+        }
+        else
+            node = GET_RIGHT(node);
+    }
+    if (fit && GET(NEXT_FREE(fit)))
+        return GET_LINK(NEXT_FREE(fit));
+    return fit;
+}
+
+/*
+ * place - place allocated block and divide if possible.
+ *       - 블록을 리스트(또는 트리)에서 빼고, 남는 부분은 다시 넣는다.
+ */
+static void place(void *bp, size_t asize)
+{
+    size_t original_size = GET_SIZE(HDRP(bp));  // 원래 블록의 사이즈
+    size_t diff = original_size - asize;
+
+    remove_free(bp);
+
+    if (diff >= MINBLKSIZE) {   // 원래 블록의 사이즈와 할당하려는 블록 사이즈의 차이가 블록의 최소크기 보다 커야 분할할 수 있다.
+
+        // 할당 처리
+        PUT(HDRP(bp) , PACK(asize, 1));             // header (asize / 1)
+        PUT(FTRP(bp) , PACK(asize, 1));             // footer (asize / 1)
+        void * leftover_bp = NEXT_BLKP(bp);
+
+        // 남은 부분 가용 처리
+        PUT(HDRP(leftover_bp), PACK(diff, 0));      // header (diff / 0)
+        PUT(FTRP(leftover_bp), PACK(diff, 0));      // footer (diff / 0)
+
+        insert_free(leftover_bp);
+    }
+    else {  // 분할 못하는 경우.
+
+        // 원래 블록을 전부 할당 처리.
+        PUT(FTRP(bp), PACK(original_size, 1));
+        PUT(HDRP(bp), PACK(original_size, 1));
+    }
+}
+
+/*
+ * mm_free - 일단 현재 블록을 free해주고, coalese 를 통해 경우에 따라 인접한 블록들을 연결을 해준다.
+ */
+void mm_free(void *bp)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    PUT(HDRP(bp), PACK(size, 0));       // size 그대로인 free 블록으로 지정.
+    PUT(FTRP(bp), PACK(size, 0));       // size 그대로인 free 블록으로 지정.
+    coalesce(bp);
+}
+
+/*
+ * insert_free - free된 블럭을 작은 리스트의 맨 앞이나 트리에 넣는다.
+*/
+static void insert_free(void *bp)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+
+    if (size < TREEBLKSIZE) {
+        void *root = SMALL_ROOT(size);
+        void *next = GET_LINK(NEXT_FREE(root));
+
+        PUT_LINK(NEXT_FREE(bp), next);
+        PUT_LINK(PREV_FREE(bp), root);
+        PUT_LINK(NEXT_FREE(root), bp);
+        if (next)
+            PUT_LINK(PREV_FREE(next), bp);
+        return;
+    }
+    PUT_LINK(TREE_ROOT, tree_insert(GET_LINK(TREE_ROOT), bp));
+}
+
+/*
+ * remove_free - 가용 블록 bp 를 리스트(또는 트리)에서 뺀다.
+ *             - 작은 리스트의 블록과 체인에 매달린 블록은 PREV_FREE 가 0 이 아니므로 O(1) 에 뺄 수 있다.
+ *             - 트리 노드는 매달린 블록이 있으면 그 블록이 노드 자리를 물려받고, 없으면 트리에서 삭제한다.
+*/
+static void remove_free(void *bp)
+{
+    void *prev = GET_LINK(PREV_FREE(bp));
+    void *next = GET_LINK(NEXT_FREE(bp));
+
+    if (prev) {
+        PUT_LINK(NEXT_FREE(prev), next);
+        if (next)
+            PUT_LINK(PREV_FREE(next), prev);
+        return;
+    }
+
+    if (next) {
+        // next 가 노드 자리를 물려받는다.
+        PUT(PREV_FREE(next), 0);
+        PUT(LEFT(next), GET(LEFT(bp)));
+        PUT(RIGHT(next), GET(RIGHT(bp)));
+        PUT(HEIGHT(next), GET(HEIGHT(bp)));
+        PUT_LINK(TREE_ROOT, tree_replace(GET_LINK(TREE_ROOT), bp, next));
+        return;
+    }
+    PUT_LINK(TREE_ROOT, tree_delete(GET_LINK(TREE_ROOT), bp));
+}
+
+/*
+ * update_height - node 의 높이를 자식들의 높이로 다시 계산한다.
+ */
+static void update_height(void *node)
+{
+    PUT(HEIGHT(node), 1 + MAX(GET_HEIGHT(GET_LEFT(node)), GET_HEIGHT(GET_RIGHT(node))));
+}
+
+/*
+ * link_offset - ptr 을 link_base 로부터의 offset 으로 바꾼다. NULL 은 0 이다.
+ */
+static unsigned int link_offset(void *ptr)
+{
+    return ptr ? (unsigned int)((char *)ptr - link_base) : 0;
+}
+
+/*
+ * rotate_left / rotate_right - 서브트리를 회전하고 새 서브트리 루트를 돌려준다.
+ *
+ *       node                 r                        node              l
+ *      /    \               / \                      /    \            / \
+ *     a      r     ->    node  c                    l      c   ->     a  node
+ *           / \          /  \                      / \                   /  \
+ *          b   c        a    b                    a   b                 b    c
+ */
+static void *rotate_left(void *node)
+{
+    void *r = GET_RIGHT(node);
+
+    PUT(RIGHT(node), GET(LEFT(r)));
+    PUT_LINK(LEFT(r), node);
+    update_height(node);
+    update_height(r);
+    return r;
+}
+
+static void *rotate_right(void *node)
+{
+    void *l = GET_LEFT(node);
+
+    PUT(LEFT(node), GET(RIGHT(l)));
+    PUT_LINK(RIGHT(l), node);
+    update_height(node);
+    update_height(l);
+    return l;
+}
+
+/*
+ * rebalance - 자식 서브트리의 높이 차이가 2 가 된 node 를 회전해서 AVL 조건을 되살린다.
+ */
+static void *rebalance(void *node)
+{
+    int balance;
+
+    update_height(node);
+    balance = GET_HEIGHT(GET_LEFT(node)) - GET_HEIGHT(GET_RIGHT(node));
+
+    if (balance > 1) {          // 왼쪽이 무겁다.
+        void *l = GET_LEFT(node);
+        if (GET_HEIGHT(GET_LEFT(l)) < GET_HEIGHT(GET_RIGHT(l)))   // left-right case
+            PUT_LINK(LEFT(node), rotate_left(l));
+        return rotate_right(node);
+    }
+    if (balance < -1) {         // 오른쪽이 무겁다.
+        void *r = GET_RIGHT(node);
+        if (GET_HEIGHT(GET_RIGHT(r)) < GET_HEIGHT(GET_LEFT(r)))   // right-left case
+            PUT_LINK(RIGHT(node), rotate_right(r));
+        return rotate_left(node);
+    }
+    return node;
+}
+
+/*
+ * tree_insert - node 를 루트로 하는 서브트리에 bp 를 넣고, 새 서브트리 루트를 돌려준다.
+ *             - 같은 크기의 노드가 이미 있으면 트리는 그대로 두고 그 노드의 체인에 매단다.
+ */
+static void *tree_insert(void *node, void *bp)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+
+    if (node == NULL) {
+        PUT(NEXT_FREE(bp), 0);
+        PUT(PREV_FREE(bp), 0);
+        PUT(LEFT(bp), 0);
+        PUT(RIGHT(bp), 0);
+        PUT(HEIGHT(bp), 1);
+        return bp;
+    }
+
+    if (size == GET_SIZE(HDRP(node))) {
+        void *next = GET_LINK(NEXT_FREE(node));
+
+        PUT_LINK(NEXT_FREE(bp), next);
+        PUT_LINK(PREV_FREE(bp), node);
+        PUT_LINK(NEXT_FREE(node), bp);
+        if (next)
+            PUT_LINK(PREV_FREE(next), bp);
+        return node;
+    }
+
+    if (size < GET_SIZE(HDRP(node)))
+        PUT_LINK(LEFT(node), tree_insert(GET_LEFT(node), bp));
+    else
+        PUT_LINK(RIGHT(node), tree_insert(GET_RIGHT(node), bp));
+    return rebalance(node);
+}
+
+/*
+ * tree_delete - node 를 루트로 하는 서브트리에서 트리 노드 bp 를 삭제하고, 새 서브트리 루트를 돌려준다.
+ *             - 자식이 둘이면 오른쪽 서브트리의 최소 노드가 bp 자리에 온다.
+ */
+static void *tree_delete(void *node, void *bp)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+
+    if (size < GET_SIZE(HDRP(node)))
+        PUT_LINK(LEFT(node), tree_delete(GET_LEFT(node), bp));
+    else if (size > GET_SIZE(HDRP(node)))
+        PUT_LINK(RIGHT(node), tree_delete(GET_RIGHT(node), bp));
+    else {
+        void *min;
+        void *right;
+
+        if (GET_LEFT(node) == NULL)
+            return GET_RIGHT(node);
+        if (GET_RIGHT(node) == NULL)
+            return GET_LEFT(node);
+
+        right = tree_delete_min(GET_RIGHT(node), &min);
+        PUT(LEFT(min), GET(LEFT(node)));
+        PUT_LINK(RIGHT(min), right);
+        node = min;
+    }
+    return rebalance(node);
+}
+
+/*
+ * tree_delete_min - 서브트리에서 가장 작은 노드를 떼어내 *min 에 담고, 새 서브트리 루트를 돌려준다.
+ */
+static void *tree_delete_min(void *node, void **min)
+{
+    if (GET_LEFT(node) == NULL) {
+        *min = node;
+        return GET_RIGHT(node);
+    }
+    PUT_LINK(LEFT(node), tree_delete_min(GET_LEFT(node), min));
+    return rebalance(node);
+}
+
+/*
+ * tree_replace - 트리 노드 bp 를 가리키던 부모의 포인터를 new_bp 로 바꾼다. 트리의 모양은 그대로다.
+ */
+static void *tree_replace(void *node, void *bp, void *new_bp)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+
+    if (node == bp)
+        return new_bp;
+    if (size < GET_SIZE(HDRP(node)))
+        PUT_LINK(LEFT(node), tree_replace(GET_LEFT(node), bp, new_bp));
+    else
+        PUT_LINK(RIGHT(node), tree_replace(GET_RIGHT(node), bp, new_bp));
+    return node;
+}
+
+/*
+ * coalesce - 인접한 가용 블록과 합친다.
+ *          - 이웃 블록을 리스트(또는 트리)에서 빼고, 합쳐진 블록을 다시 넣는다.
+ */
+static void *coalesce(void *bp)
+{
+    size_t prev_alloc = GET_ALLOC(bp - DSIZE);              // 앞 블록의 할당 여부  // prologue에는 header가 없어서 이런 방식으로 계산.
+    size_t next_alloc = GET_ALLOC(HDRP(NEXT_BLKP(bp)));     // 뒤 블록의 할당 여부
+    size_t size = GET_SIZE(HDRP(bp));                       // 현재 블록의 사이즈
+
+    /* case 1 : 앞, 뒤 블록 모두 allocated 인 경우. */
+    if (prev_alloc && next_alloc) {
+    }
+    /* case 3 : 앞 블록만 free 인 경우. */
+    else if (next_alloc) {
+        remove_free(PREV_BLKP(bp));
+        size += GET_SIZE(HDRP(PREV_BLKP(bp)));
+        PUT(FTRP(bp), PACK(size, 0));
+        PUT(HDRP(PREV_BLKP(bp)), PACK(size, 0));
+        bp = PREV_BLKP(bp);
+    }
+    /* case 2 : 뒤 블록만 free 인 경우. */
+    else if (prev_alloc) {
+        remove_free(NEXT_BLKP(bp));
+        size += GET_SIZE(HDRP(NEXT_BLKP(bp)));
+        PUT(HDRP(bp), PACK(size, 0));
+        PUT(FTRP(bp), PACK(size, 0));
+    }
+    /* case 4 : 앞, 뒤 블록 모두 free 인 경우. */
+    else {
+        remove_free(PREV_BLKP(bp));
+        remove_free(NEXT_BLKP(bp));
+        size += GET_SIZE(HDRP(PREV_BLKP(bp))) + GET_SIZE(FTRP(NEXT_BLKP(bp)));
+        PUT(HDRP(PREV_BLKP(bp)), PACK(size, 0));
+        PUT(FTRP(NEXT_BLKP(bp)), PACK(size, 0));
+        bp = PREV_BLKP(bp);
+    }
+    insert_free(bp);
+    return bp;
+}
+
+/*
+ * mm_realloc - Implemented simply in terms of mm_malloc and mm_free
+ */
+void *mm_realloc(void *bp, size_t size)
+{
+    void *oldptr = bp;
+    void *newptr;
+    size_t copySize;
+
+    newptr = mm_malloc(size);
+    if (newptr == NULL)
+      return NULL;
+    copySize = GET_SIZE(HDRP(oldptr)) - DSIZE;
+    if (size < copySize)
+      copySize = size;
+    memcpy(newptr, oldptr, copySize);
+
+    mm_free(oldptr);
+    return newptr;
+}
+
+/*
+ * mm_memalign - payload 가 alignment 의 배수에 오는 블록을 준다. alignment 는 2의 거듭제곱이어야 한다.
+ */
+void *mm_memalign(size_t alignment, size_t size)
+{
+    return mm_memalign_offset(alignment, 0, size);
+}
+
+/*
+ * mm_memalign_offset - payload + offset 이 alignment 의 배수에 오는 블록을 준다. offset 은 ALIGNMENT 의 배수이다.
+ *                    - 먼저 asize 의 best-fit 블록에 그 자리가 있는지 보고, 없으면 앞 조각 (MINBLKSIZE 이상, alignment 미만) 이
+ *                      생겨도 asize 가 들어가는 크기로 다시 best-fit 한다. 그래도 없으면 그 크기만큼 힙을 늘린다.
+ *                    - 앞 조각은 가용 블록으로 떼어서 리스트나 트리에 넣는다.
+ */
+void *mm_memalign_offset(size_t alignment, size_t offset, size_t size)
+{
+    size_t asize, gsize;
+    char *p = NULL;
+    void *bp;
+
+    if (size == 0 || (alignment & (alignment - 1)) || offset % ALIGNMENT)
+        return NULL;
+    if (alignment <= ALIGNMENT)
+        return mm_malloc(size);
+
+    if (size <= MINBLKSIZE - DSIZE)
+        asize = MINBLKSIZE;
+    else
+        asize = ALIGN(size) + DSIZE;
+    gsize = asize + alignment + MINBLKSIZE;
+
+    if ((bp = find_fit(asize)) != NULL)
+        p = aligned_spot(bp, asize, alignment, offset);
+    if (p == NULL) {
+        if ((bp = find_fit(gsize)) == NULL && (bp = extend_heap(MAX(gsize, CHUNKSIZE)/WSIZE)) == NULL)
+            return NULL;
+        p = aligned_spot(bp, asize, alignment, offset);
+    }
+    place_aligned(bp, p, asize);
+    return p;
+}
+
+/*
+ * aligned_spot - 가용 블록 bp 안에서 asize 블록의 payload + offset 이 alignment 경계에 오는 가장 앞 자리를 돌려준다. 없으면 NULL.
+ *              - 앞에 남는 조각은 없거나 (p == bp) MINBLKSIZE 이상이어야 가용 블록이 될 수 있다.
+ */
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset)
+{
+    char *p = (char *)((((size_t)bp + offset + alignment - 1) & ~(alignment - 1)) - offset);
+
+    if (p != (char *)bp && p - (char *)bp < MINBLKSIZE)
+        p += alignment;
+    return p + asize <= (char *)bp + GET_SIZE(HDRP(bp)) ? p : NULL;
+}
+
+/*
+ * place_aligned - 가용 블록 bp 의 p 자리에 asize 블록을 할당한다.
+ *               - 앞 조각은 크기 (트리의 키) 가 바뀌므로 빼고 다시 넣는다. p 부터는 가용 블록으로 만들어 place 에 맡긴다.
+ */
+static void place_aligned(void *bp, char *p, size_t asize)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    size_t lead = p - (char *)bp;
+
+    if (lead > 0) {
+        remove_free(bp);
+        PUT(HDRP(bp), PACK(lead, 0));
+        PUT(FTRP(bp), PACK(lead, 0));
+        insert_free(bp);
+        PUT(HDRP(p), PACK(size - lead, 0));
+        PUT(FTRP(p), PACK(size - lead, 0));
+        insert_free(p);
+    }
+    place(p, asize);
+}
+
+/*
+ * mm_free_sized - this engine does not use the size; same as mm_free.
+ */
+void mm_free_sized(void *ptr, size_t size)
+{
+    mm_free(ptr);
+}
+
+/*
+ * mm_usable_size - payload bytes of the block at ptr, at least the size it was requested with.
+ */
+size_t mm_usable_size(void *ptr)
+{
+    return GET_SIZE(HDRP(ptr)) - DSIZE;
+}
+
+/*
+ * mm_malloc_batch - this engine has no batch path; n calls to mm_malloc. Returns how many succeeded.
+ */
+size_t mm_malloc_batch(size_t size, size_t n, void **out)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if ((out[i] = mm_malloc(size)) == NULL)
+            break;
+    return i;
+}
+
+/*
+ * mm_free_batch - this engine has no batch path; n calls to mm_free.
+ */
+void mm_free_batch(void **ptrs, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        mm_free(ptrs[i]);
+}
+
+/*
+ * mm_set_place - this engine has one placement; the rule is ignored.
+ */
+void mm_set_place(size_t size, int end)
+{
+}
+
+/*
+ * mm_set_fit - this engine has one fit policy; the policy is ignored.
+ */
+void mm_set_fit(int policy)
+{
+}
+
+/*
+ * mm_malloc_flags - this engine takes no placement hints; mm_malloc, with the payload cleared for MALLOC_ZERO.
+ */
+void *mm_malloc_flags(size_t size, int flags, void *near)
+{
+    void *p = mm_malloc(size);
+
+    if (p != NULL && (flags & MALLOC_ZERO))
+        memset(p, 0, size);
+    return p;
+}
+
+/*
+ * mm_report - this engine keeps no counters.
+ */
+void mm_report(void)
+{
+}
+
+/*
+ * check_tree - 서브트리의 BST 순서 (lo < key < hi), 높이, AVL 균형, 체인을 검사하고 높이를 돌려준다.
+ *            - *cnt 에는 트리와 체인에 들어있는 블록 수를 더한다.
+ */
+static int check_tree(void *node, size_t lo, size_t hi, int *cnt)
+{
+    size_t size;
+    int lh, rh;
+    void *prev, *next;
+
+    if (node == NULL)
+        return 0;
+
+    size = GET_SIZE(HDRP(node));
+    assert(!GET_ALLOC(HDRP(node)));
+    assert(lo < size && size < hi);                     // check BST order, keys are unique
+    assert(GET(PREV_FREE(node)) == 0);                  // check tree node mark
+
+    // check chain of the same size
+    (*cnt)++;
+    for (prev = node, next = GET_LINK(NEXT_FREE(node)); next != NULL; prev = next, next = GET_LINK(NEXT_FREE(next))) {
+        assert(!GET_ALLOC(HDRP(next)));
+        assert(GET_SIZE(HDRP(next)) == size);
+        assert(GET_LINK(PREV_FREE(next)) == prev);
+        (*cnt)++;
+    }
+
+    lh = check_tree(GET_LEFT(node), lo, size, cnt);
+    rh = check_tree(GET_RIGHT(node), size, hi, cnt);
+    assert(GET_HEIGHT(node) == 1 + MAX(lh, rh));      // check height
+    assert(lh - rh <= 1 && rh - lh <= 1);               // check AVL balance
+    return GET_HEIGHT(node);
+}
+
+/*
+ * mm_checkheap - check heap invariants for this implementation.
+ *
+ * #ifdef DEBUG
+ *   CHECKHEAP();
+ * #endif
+*/
+void mm_checkheap(int lineno)
+{
+    char *heap_lo = mem_heap_lo();                      // pointing first word of the heap
+    char *heap_hi = heap_lo + (mem_heapsize()-WSIZE);   // pointing last word of the heap
+    char *bp;
+    size_t size;
+    int heap_free_cnt = 0;
+    int list_free_cnt = 0;
+
+    /* heap level check*/
+    assert(GET(heap_lo + 4*WSIZE) == PACK(WSIZE,1));    // check PROLOGUE footer
+    assert(GET(heap_hi) == PACK(0,1));                  // check epilogue block
+
+    /* block level */
+    // prologue footer (4/1) 의 크기는 GET_SIZE 로 읽으면 0 이므로, 첫 번째 블록부터 순회한다.
+    for(bp = heap_listp + WSIZE ; GET_SIZE(HDRP(bp)) > 0 ; bp = NEXT_BLKP(bp)) {
+        assert(GET(HDRP(bp)) == GET(FTRP(bp)));     // check header and footer match
+        assert(!(UINT_CAST(bp) & 0x7));             // check if payload area aligned
+        assert(GET_ALLOC(HDRP(bp)) | GET_ALLOC(HDRP(NEXT_BLKP(bp))));   // check contiguous free blocks
+        assert(heap_lo < HDRP(bp) && FTRP(bp) < heap_hi);               // check heap bound
+        if (!GET_ALLOC(HDRP(bp)))
+            heap_free_cnt++;
+    }
+
+    /* list level check */
+    for (size = MINBLKSIZE; size < TREEBLKSIZE; size += DSIZE) {
+        void *prev = SMALL_ROOT(size);
+        void *next;
+        for (next = GET_LINK(NEXT_FREE(prev)); next != NULL; prev = next, next = GET_LINK(NEXT_FREE(next))) {
+            assert(!GET_ALLOC(HDRP(next)));
+            assert(GET_SIZE(HDRP(next)) == size);           // check block is in the right list
+            assert(GET_LINK(PREV_FREE(next)) == prev);   // check back link
+            assert(++list_free_cnt <= heap_free_cnt);       // detect cycle
+        }
+    }
+
+    /* tree level check */
+    check_tree(GET_LINK(TREE_ROOT), TREEBLKSIZE - 1, (size_t)-1, &list_free_cnt);
+    assert(heap_free_cnt == list_free_cnt);     // every free block is in exactly one list or the tree
+}
@@ -0,0 +1,494 @@
+/*
+ * mm-buddy.c - binary buddy allocator, w/ per-order LIFO free-lists, XOR buddy lookup.
+ *
+ * 모든 블록의 크기는 2의 거듭제곱 (2^order bytes, order >= MIN_ORDER) 이고, base 로부터의 offset 이 자기 크기의 배수이다.
+ * 그래서 offset 이 off 인 order k 블록의 buddy 는 항상 offset (off ^ 2^k) 에 있고, 둘을 합치면 order k+1 블록이 된다.
+ *  - 할당 : order 가 충분한 가장 작은 가용 블록을 찾아, 필요한 order 가 될 때까지 반으로 나누고 윗 절반은 가용 리스트에 넣는다.
+ *  - 반환 : buddy 가 같은 order 의 가용 블록이면 합치기를 반복한다. footer 가 필요 없다.
+ *  - 가용 블록이 없으면 힙 끝에 2^order 블록을 mem_sbrk 한다. 힙 끝이 2^order 로 정렬돼 있지 않으면
+ *    먼저 정렬될 때까지 작은 블록들을 붙여서 가용 리스트에 넣는다.
+ * 블록은 order 와 할당 비트를 담은 4 bytes header 만 가진다. 가용 블록은 추가로 next / prev free block pointer 를 가진다.
+ * order 마다 LIFO 명시적 가용 리스트가 있고, 비어 있지 않은 리스트는 free_map 의 비트로 표시된다.
+ * base 를 (8의 배수 + 4) 에 두어서, header 바로 뒤의 payload 가 더블워드 정렬되게 한다. 블록의 최소 크기는 16 bytes 이다.
+ *
+ * NOTE TO STUDENTS: Replace this header comment with your own header
+ * comment that gives a high level description of your solution.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "mm.h"
+#include "memlib.h"
+
+/*********************************************************
+ * NOTE TO STUDENTS: Before you do anything else, please
+ * provide your team information in the following struct.
+ ********************************************************/
+team_t team = {
+    /* Team name */
+    "JUNGLE_W06_TEAM_7",
+    /* First member's full name */
+    "LEE_KANG_WOOK",
+    /* First member's email address */
+    "dlrkddnr0421@daum.net",
+    /* Second member’s full name (leave blank if none) */
+    "",
+    /* Second member’s email address (leave blank if none) */
+    ""
+};
+
+/* Basic constants and macros*/
+
+#define WSIZE       4       /* Word and header size (bytes) */
+#define DSIZE       8       /* Double word size (bytes) */
+#ifndef ALIGNMENT
+#define ALIGNMENT   8       /* double word (8) alignment */
+#endif
+#if ALIGNMENT != 8
+#error "mm-buddy.c supports only 8-byte alignment"
+#endif
+
+/* Buddy constants */
+#define MIN_ORDER   4       /* smallest block is 16 bytes : header, next and prev free pointers */
+#define MAX_ORDER   30      /* largest block order; the heap never gets near 2^MAX_ORDER bytes */
+
+/* Pack an order and allocated bit into a header */
+#define PACK(order, alloc)  (((order) << 1) | (alloc))
+
+/* Read and write a word at address p */
+#define GET(p) (*((unsigned int *)(p)))
+#define PUT(p, val) (*(unsigned int *)(p) = (val))
+
+/* Read the order and allocated fields from header address p */
+#define GET_ORDER(p)    (GET(p) >> 1)
+#define GET_ALLOC(p)    (GET(p) & 0x1)
+#define UINT_CAST(p)    ((size_t)p)
+
+/* bp(block pointer) : payload의 시작 주소를 가리키는 포인터이다. 헤더를 가리키지 않는다. */
+#define HDRP(bp)        ((char *)(bp) - WSIZE)
+#define BLKP(hp)        ((char *)(hp) + WSIZE)
+
+/* size of an order, and offset of a block (given by its header address) from base */
+#define ORDER_SIZE(k)   ((size_t)1 << (k))
+#define OFFSET(hp)      ((size_t)((char *)(hp) - base))
+
+/* header address of the buddy of the order k block whose header is at hp */
+#define BUDDY(hp, k)    (base + (OFFSET(hp) ^ ORDER_SIZE(k)))
+
+/* Given free block ptr bp, compute address of previous and next free blocks */
+#define NEXT_FREE(bp)   ((void *)((char *)bp))
+#define PREV_FREE(bp)   ((void *)((char *)bp + WSIZE))
+
+/* Read and write a free-list link at address p : 32-bit offset from link_base, 0 is NULL */
+#define GET_LINK(p)         ((void *)(GET(p) ? link_base + GET(p) : NULL))
+#define PUT_LINK(p, ptr)    PUT(p, (ptr) ? (unsigned int)((char *)(ptr) - link_base) : 0)
+
+/* heap checker */
+#ifdef DEBUG
+# define CHECKHEAP() printf("\n%s : %d\n", __func__,__LINE__); mm_checkheap(__LINE__);
+#endif
+
+/* private variables */
+static char *base;                          /* header address of the block at offset 0, 4 mod 8 */
+static char *heap_end;                      /* one past the last block (the brk) */
+static void *free_lists[MAX_ORDER + 1];     /* LIFO list heads per order, NULL if empty */
+static unsigned int free_map;               /* bit k set : free_lists[k] is not empty */
+static char *link_base;                     /* free-list links are offsets from here */
+
+/* buddy counters, reset by mm_init */
+static struct {
+    int splits;     /* blocks halved on the way down to the requested order */
+    int merges;     /* buddy pairs merged on free */
+    int grows;      /* blocks added at the heap end */
+    int in_place;   /* reallocs served without moving */
+} buddy_stats;
+
+/* private function declarations */
+int mm_init(void);
+static int size_order(size_t size);
+static void *grow_heap(int order);
+static void insert_free(void *bp, int order);
+static void remove_free(void *bp, int order);
+static void *split_down(void *bp, int order, int target);
+static void mm_checkheap(int lineno);
+
+/*
+ * mm_init - base 가 (8의 배수 + 4) 에 오도록 패딩 한 워드만 잡는다. 블록은 처음 할당할 때 만든다.
+ *
+ * @                          @  - double word alignment
+ * |   padding   |  HEADER   |    payload ...
+ *               ^
+ *              base
+ */
+int mm_init(void)
+{
+    char *p;
+
+    link_base = (char *)mem_heap_lo() - WSIZE;  // 힙 맨 앞 블록도 0 이 아닌 offset 을 갖도록 한 워드 앞에 둔다.
+    if ((p = mem_sbrk(WSIZE)) == (void *)-1)
+        return -1;
+    base = heap_end = p + WSIZE;
+    memset(free_lists, 0, sizeof(free_lists));
+    free_map = 0;
+    memset(&buddy_stats, 0, sizeof(buddy_stats));
+    return 0;
+}
+
+/*
+ * size_order - header 를 포함해서 size 바이트가 들어가는 가장 작은 order. MAX_ORDER 를 넘으면 -1.
+ */
+static int size_order(size_t size)
+{
+    size_t need = size + WSIZE;
+    int order;
+
+    if (need <= ORDER_SIZE(MIN_ORDER))
+        return MIN_ORDER;
+    order = 32 - __builtin_clz((unsigned int)(need - 1));     // ceil(log2(need))
+    return order <= MAX_ORDER ? order : -1;
+}
+
+/*
+ * mm_malloc - 가장 작은 충분한 가용 블록을 찾아 order 까지 나누고, 없으면 힙 끝에 만든다.
+ */
+void *mm_malloc(size_t size)
+{
+    int order, k;
+    unsigned int avail;
+    void *bp;
+
+    if (size == 0 || (order = size_order(size)) < 0)
+        return NULL;
+
+    avail = free_map & ~((1u << order) - 1);        // order 이상인 비어 있지 않은 리스트들
+    if (avail) {
+        k = __builtin_ctz(avail);
+        bp = free_lists[k];
+        remove_free(bp, k);
+        bp = split_down(bp, k, order);
+    }
+    else if ((bp = grow_heap(order)) == NULL)
+        return NULL;
+
+    PUT(HDRP(bp), PACK(order, 1));
+    return bp;
+}
+
+/*
+ * split_down - order 블록 bp 를 target 이 될 때까지 반으로 나누고, 윗 절반들은 가용 리스트에 넣는다.
+ */
+static void *split_down(void *bp, int order, int target)
+{
+    while (order > target) {
+        order--;
+        insert_free(BLKP(HDRP(bp) + ORDER_SIZE(order)), order);
+        buddy_stats.splits++;
+    }
+    PUT(HDRP(bp), PACK(order, 0));
+    return bp;
+}
+
+/*
+ * grow_heap - 힙 끝에 order 블록을 하나 만든다.
+ *           - 힙 끝이 2^order 로 정렬돼 있지 않으면, 정렬될 때까지 힙 끝에 맞는 크기의 가용 블록들을 먼저 붙인다.
+ *             (힙 끝 offset 의 가장 낮은 1 비트가 그 자리에 놓을 수 있는 가장 큰 블록이다.)
+ */
+static void *grow_heap(int order)
+{
+    size_t size = ORDER_SIZE(order);
+    char *hp;
+    int k;
+
+    while (OFFSET(heap_end) & (size - 1)) {
+        k = __builtin_ctz((unsigned int)OFFSET(heap_end));
+        if ((hp = mem_sbrk(ORDER_SIZE(k))) == (void *)-1)
+            return NULL;
+        heap_end = hp + ORDER_SIZE(k);
+        buddy_stats.grows++;
+        PUT(hp, PACK(k, 1));    // mm_free 처럼 buddy 와 합치면서 가용 리스트에 넣는다.
+        mm_free(BLKP(hp));
+    }
+
+    if ((hp = mem_sbrk(size)) == (void *)-1)
+        return NULL;
+    heap_end = hp + size;
+    buddy_stats.grows++;
+    return BLKP(hp);
+}
+
+/*
+ * insert_free - order 가용 블록 bp 를 리스트 맨 앞에 넣는다.
+ */
+static void insert_free(void *bp, int order)
+{
+    void *next = free_lists[order];
+
+    PUT(HDRP(bp), PACK(order, 0));
+    PUT_LINK(NEXT_FREE(bp), next);
+    PUT(PREV_FREE(bp), 0);
+    if (next)
+        PUT_LINK(PREV_FREE(next), bp);
+    free_lists[order] = bp;
+    free_map |= 1u << order;
+}
+
+/*
+ * remove_free - order 가용 블록 bp 를 리스트에서 뺀다.
+ */
+static void remove_free(void *bp, int order)
+{
+    void *next = GET_LINK(NEXT_FREE(bp));
+    void *prev = GET_LINK(PREV_FREE(bp));
+
+    if (prev)
+        PUT_LINK(NEXT_FREE(prev), next);
+    else if ((free_lists[order] = next) == NULL)
+        free_map &= ~(1u << order);
+    if (next)
+        PUT_LINK(PREV_FREE(next), prev);
+}
+
+/*
+ * mm_free - buddy 가 같은 order 의 가용 블록인 동안 합친 뒤, 가용 리스트에 넣는다.
+ *         - buddy 가 아직 힙 끝 너머에 있으면 합치지 않는다.
+ */
+void mm_free(void *bp)
+{
+    char *hp = HDRP(bp);
+    int order = GET_ORDER(hp);
+    char *buddy;
+
+    while (order < MAX_ORDER) {
+        buddy = BUDDY(hp, order);
+        if (buddy + ORDER_SIZE(order) > heap_end || GET_ALLOC(buddy) || GET_ORDER(buddy) != order)
+            break;
+        remove_free(BLKP(buddy), order);
+        if (buddy < hp)
+            hp = buddy;     // 합친 블록은 둘 중 앞쪽에서 시작한다.
+        order++;
+        buddy_stats.merges++;
+    }
+    insert_free(BLKP(hp), order);
+}
+
+/*
+ * mm_realloc - 들어가면 남는 윗 절반들을 떼어 내고, 모자라면 내가 아래쪽 절반인 동안 가용 buddy 를 흡수해서 제자리에서 늘린다.
+ *              buddy 가 힙 끝 너머이면 mem_sbrk 로 만들어서 흡수한다. 안 되면 새로 할당해서 복사한다.
+ */
+void *mm_realloc(void *bp, size_t size)
+{
+    char *hp, *buddy, *end;
+    int order, target, k;
+    void *newptr;
+    size_t copySize;
+
+    if (bp == NULL)
+        return mm_malloc(size);
+    if (size == 0) {
+        mm_free(bp);
+        return NULL;
+    }
+    if ((target = size_order(size)) < 0)
+        return NULL;
+
+    hp = HDRP(bp);
+    order = GET_ORDER(hp);
+
+    /* 줄이기 : 남는 윗 절반들을 가용 리스트에 돌려준다. */
+    if (target <= order) {
+        while (order > target) {
+            order--;
+            PUT(hp, PACK(order, 1));
+            PUT(hp + ORDER_SIZE(order), PACK(order, 1));
+            mm_free(BLKP(hp + ORDER_SIZE(order)));  // 윗 절반의 buddy 는 나이므로 더 합쳐지지 않는다.
+        }
+        buddy_stats.in_place++;
+        return bp;
+    }
+
+    /* 늘리기 : 내가 아래쪽 절반이고 윗 buddy 가 다 비어 있으면 흡수한다. */
+    end = heap_end;
+    for (k = order; k < target; k++) {
+        buddy = BUDDY(hp, k);
+        if (buddy < hp)
+            break;      // 윗 절반이면 앞으로 옮겨야 하므로 제자리에서는 안 된다.
+        if (buddy == end) {
+            end += ORDER_SIZE(k);
+            continue;   // 힙 끝 너머는 아래에서 mem_sbrk 로 만든다.
+        }
+        if (buddy + ORDER_SIZE(k) > end || GET_ALLOC(buddy) || GET_ORDER(buddy) != k)
+            break;
+    }
+    if (k == target) {
+        for (k = order; k < target; k++) {
+            buddy = BUDDY(hp, k);
+            if (buddy == heap_end) {
+                if (mem_sbrk(ORDER_SIZE(k)) == (void *)-1)
+                    break;
+                heap_end += ORDER_SIZE(k);
+                buddy_stats.grows++;
+            }
+            else
+                remove_free(BLKP(buddy), k);
+            PUT(hp, PACK(k + 1, 1));
+            buddy_stats.merges++;
+        }
+        if (k == target) {
+            buddy_stats.in_place++;
+            return bp;
+        }
+    }
+    order = GET_ORDER(hp);      // mem_sbrk 가 도중에 실패했으면 늘어난 만큼이 지금 order 이다.
+
+    /* 복사 */
+    if ((newptr = mm_malloc(size)) == NULL)
+        return NULL;
+    copySize = ORDER_SIZE(order) - WSIZE;
+    if (size < copySize)
+        copySize = size;
+    memcpy(newptr, bp, copySize);
+    mm_free(bp);
+    return newptr;
+}
+
+/*
+ * mm_memalign - this engine has no aligned placement. Alignments up to ALIGNMENT are plain mm_malloc;
+ *               larger ones fail with a message instead of padding the block by a whole alignment.
+ */
+void *mm_memalign(size_t alignment, size_t size)
+{
+    return mm_memalign_offset(alignment, 0, size);
+}
+
+/*
+ * mm_memalign_offset - same as mm_memalign, for payload + offset. Every payload is ALIGNMENT-aligned, so offset must be a multiple of it.
+ */
+void *mm_memalign_offset(size_t alignment, size_t offset, size_t size)
+{
+    if (alignment <= ALIGNMENT && offset % ALIGNMENT == 0)
+        return mm_malloc(size);
+    fprintf(stderr, "ERROR: mm_memalign(%u) failed. mm-buddy.c has no aligned placement...\n", (unsigned int)alignment);
+    return NULL;
+}
+
+/*
+ * mm_free_sized - this engine does not use the size; same as mm_free.
+ */
+void mm_free_sized(void *ptr, size_t size)
+{
+    mm_free(ptr);
+}
+
+/*
+ * mm_usable_size - payload bytes of the block at ptr, at least the size it was requested with.
+ */
+size_t mm_usable_size(void *ptr)
+{
+    return ORDER_SIZE(GET_ORDER(HDRP(ptr))) - WSIZE;
+}
+
+/*
+ * mm_malloc_batch - this engine has no batch path; n calls to mm_malloc. Returns how many succeeded.
+ */
+size_t mm_malloc_batch(size_t size, size_t n, void **out)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if ((out[i] = mm_malloc(size)) == NULL)
+            break;
+    return i;
+}
+
+/*
+ * mm_free_batch - this engine has no batch path; n calls to mm_free.
+ */
+void mm_free_batch(void **ptrs, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        mm_free(ptrs[i]);
+}
+
+/*
+ * mm_set_place - this engine has one placement; the rule is ignored.
+ */
+void mm_set_place(size_t size, int end)
+{
+}
+
+/*
+ * mm_set_fit - this engine has one fit policy; the policy is ignored.
+ */
+void mm_set_fit(int policy)
+{
+}
+
+/*
+ * mm_malloc_flags - this engine takes no placement hints; mm_malloc, with the payload cleared for MALLOC_ZERO.
+ */
+void *mm_malloc_flags(size_t size, int flags, void *near)
+{
+    void *p = mm_malloc(size);
+
+    if (p != NULL && (flags & MALLOC_ZERO))
+        memset(p, 0, size);
+    return p;
+}
+
+/*
+ * mm_report - print split / merge / grow counts since mm_init.
+ */
+void mm_report(void)
+{
+    printf("buddy: %d splits, %d merges, %d grows, %d reallocs in place\n",
+           buddy_stats.splits, buddy_stats.merges, buddy_stats.grows, buddy_stats.in_place);
+}
+
+/*
+ * mm_checkheap - check heap invariants for this implementation.
+ *
+ * #ifdef DEBUG
+ *   CHECKHEAP();
+ * #endif
+ */
+static void mm_checkheap(int lineno)
+{
+    char *hp;
+    void *bp;
+    int order, heap_free_cnt = 0, list_free_cnt = 0;
+
+    assert((char *)mem_heap_hi() + 1 == heap_end);      // check heap_end is the brk
+    assert(!(UINT_CAST(base + WSIZE) & 0x7));          // check payloads are double word aligned
+
+    /* block level */
+    for (hp = base; hp < heap_end; hp += ORDER_SIZE(order)) {
+        order = GET_ORDER(hp);
+        assert(MIN_ORDER <= order && order <= MAX_ORDER);
+        assert(!(OFFSET(hp) & (ORDER_SIZE(order) - 1)));   // check block is aligned to its size
+        assert(hp + ORDER_SIZE(order) <= heap_end);         // check heap bound
+        if (!GET_ALLOC(hp)) {
+            char *buddy = BUDDY(hp, order);
+            heap_free_cnt++;
+            assert(free_map & (1u << order));
+            // check coalescing : a free block's buddy is never a free block of the same order
+            assert(buddy + ORDER_SIZE(order) > heap_end || GET_ALLOC(buddy) || GET_ORDER(buddy) != order);
+        }
+    }
+    assert(hp == heap_end);
+
+    /* list level check */
+    for (order = 0; order <= MAX_ORDER; order++) {
+        assert(!(free_lists[order] == NULL) == !!(free_map & (1u << order)));     // check free_map
+        for (bp = free_lists[order]; bp != NULL; bp = GET_LINK(NEXT_FREE(bp))) {
+            assert(!GET_ALLOC(HDRP(bp)) && GET_ORDER(HDRP(bp)) == order);
+            assert(GET_LINK(NEXT_FREE(bp)) == NULL || GET_LINK(PREV_FREE(GET_LINK(NEXT_FREE(bp)))) == bp);
+            assert(++list_free_cnt <= heap_free_cnt);       // also stops a cycle
+        }
+    }
+    assert(heap_free_cnt == list_free_cnt);
+}
@@ -2,8 +2,47 @@
  * mm-explicit.c - explicit free-list, w/ address order, immediate boundary-tag coalescing.
  * 
  * 경계 태그 연결(boundary-tag coalescing)을 사용하는 명시적 가용 리스트 (explicit free-list)에 기초한 할당기.
- * 모든 블록은 header와 footer을 가지며, 가용 블록은 추가로 prev free block pointer와 next free block pointer를 가진다.
- * 더블워드 정렬 기준이다. 블록의 최소 크기(바이트) 는 16 bytes 이다.
+ * 모든 블록은 header를 가지며, 가용 블록만 추가로 footer와 prev free block pointer, next free block pointer를 가진다.
+ * 할당 블록에는 footer가 없다. 대신 header의 PREV_ALLOC 비트에 앞 블록의 할당 여부를 기록해서, 앞 블록이 가용일 때만 footer를 읽는다.
+ * 더블워드 정렬 기준이다. 블록의 최소 크기(바이트) 는 16 bytes 이다. (할당 블록은 header 4 bytes 만 쓰므로 12 bytes 까지의 요청이 최소 블록에 들어간다)
+ *
+ * 가용 리스트는 주소 순이고, 그 위에 skip list 를 얹어서 삽입 자리를 O(log n) 에 찾는다.
+ * NEXT_FREE / PREV_FREE 리스트가 0 층이고, 1 층부터는 가용 블록의 payload 안에 층마다 한 워드씩 다음 블록 링크를 둔다.
+ * 탑의 높이는 블록 주소의 해시로 정하고 (한 층 올라갈 확률 1/4), 블록 안에 들어가는 만큼으로 자른다. 그래서 16 bytes 블록은 0 층에만 있다.
+ * find_fit 과 mm_memalign 은 0 층만 따라가므로 address-ordered first fit 은 그대로이다.
+ *
+ * DEFER_COALESCE 가 켜져 있으면 QUICK_MAX 이하의 블록은 free 할 때 합치지 않고 크기별 quick list 에 넣어 둔다. (deferred coalescing)
+ * quick list 의 블록은 header 상으로는 할당 블록 그대로라서 이웃 블록과 합쳐지지 않고, 같은 크기의 다음 요청에 바로 재사용된다.
+ * 가용 리스트에서 맞는 블록을 못 찾았을 때나, quick list 에 쌓인 바이트가 DEFER_LIMIT 을 넘었을 때
+ * flush_quick 이 quick list 의 블록을 모두 한꺼번에 free 하고 합친다. 그 뒤에는 즉시 연결할 때와 같은 힙 모양이 된다.
+ *
+ * 힙이 모자라면 grow_heap 이 늘린다. 마지막 블록이 가용이면 모자란 만큼만 늘리고, 아니면 grow_step 만큼 늘리면서
+ * grow_step 을 GROW_MAX 까지 두 배씩 키운다. (geometric growth) trim_tail 이 힙을 줄이면 grow_step 은 반으로 준다.
+ *
+ * mm_malloc 은 크기 클래스 (2의 거듭제곱 구간을 넷으로 나눈 PLACE_CLASS) 마다 정해 둔 쪽에서 가용 블록을 자른다. PLACE_LOW 면 앞에서 잘라서 남은 블록이 뒤에,
+ * PLACE_HIGH 면 뒤에서 잘라서 남은 블록이 앞에 남는다. 기본은 PLACE_SPLIT 바이트 이상의 블록만 PLACE_HIGH 이고, mm_set_place 로 바꾼다.
+ * 큰 블록과 작은 블록을 양 끝에서 자르면 서로 끼어들지 않아서, 한쪽이 free 됐을 때 합쳐질 이웃이 남는다.
+ *
+ * find_fit 은 기본으로 first fit 이고, mm_set_fit(FIT_NEXT) 이면 next fit 이다. next fit 은 지난 검색이 멈춘 가용 블록 (rover) 에서 시작해서
+ * 리스트 끝까지 보고 머리로 돌아와 rover 앞까지 본다. rover 가 가리키는 블록이 리스트에서 빠지면 remove_free / replace_free 가 rover 를 옮긴다.
+ *
+ * TINY_PAGES 가 켜져 있으면 TINY_MAX (64) 바이트 이하의 요청은 힙이 아니라 tiny page 에서 준다. (mm-slab.c 의 slab 과 같은 구조)
+ *  - tiny page 는 TINY_PAGE (1024) 바이트로 정렬된 한 덩어리로, 한 크기 클래스 (8, 16, 24, 32, 48, 64 bytes) 의 slot 들로 나뉜다.
+ *    페이지 맨 앞의 tiny_t 에 클래스, 가용 slot 수, slot 마다 한 비트인 bitmap 이 있고, slot 에는 header 도 footer 도 없다.
+ *  - 페이지들은 mm_init 이 mem_region_new 로 받은 전용 region 에서 한 페이지씩 떼어 온다. region 이 페이지 경계에서 시작하므로
+ *    mm_free 는 주소가 region 안이면 하위 비트를 지워서 tiny_t 를 찾는다.
+ *  - region 이 다 차면 작은 요청도 힙으로 간다.
+ *
+ * SHORT_REGION 이 켜져 있으면 금방 free 될 것 같은 블록은 region 0 이 아니라 short-lived region 에 둔다. (기본은 꺼져 있다. -DSHORT_REGION=1 로 켠다.)
+ *  - short-lived region 은 mm_init 이 mem_region_new 로 받는 두 번째 힙이다. prologue 없이 padding 과 epilogue 로 시작하고 블록 모양은 같다.
+ *    region 0 위에 있으므로 주소 순 가용 리스트에서 그 가용 블록들은 모두 region 0 의 가용 블록 뒤에 온다.
+ *    find_fit 은 오래 살 요청이면 short_lo 에서 멈추고, 금방 죽을 요청이면 skip list 로 short_lo 뒤의 첫 가용 블록을 찾아 거기서 시작한다.
+ *  - 예측은 place class 마다 둔 점수로 한다. 할당할 때 birth table 에 주소와 시각 (malloc/free 호출 수) 을 적어 두고,
+ *    free 할 때 table 에 남아 있으면 LIFE_SHORT 안에 죽었는지를 보고 점수를 고친다. 호출 위치는 알 수 없으므로 크기로만 예측한다.
+ *  - LIFE_MAX_SIZE 이하의 블록만 옮긴다. 오래 사는 블록을 잘못 보내면 그 region 의 공간을 붙잡고 있기 때문이다.
+ *
+ * FIT_PROBES 가 0 이 아니면 find_fit 은 가용 블록을 최대 FIT_PROBES 개만 본다. (latency-bounded mode)
+ * 그 안에 맞는 블록이 없으면 더 찾지 않고 힙을 늘린다. 한 번의 malloc 이 도는 시간에 상한이 생기는 대신 힙이 더 커질 수 있다.
  *
  * NOTE TO STUDENTS: Replace this header comment with your own header
  * comment that gives a high level description of your solution.
@@ -13,6 +52,7 @@
 #include <assert.h>
 #include <unistd.h>
 #include <string.h>
+#include <stdint.h>
 
 #include "mm.h"
 #include "memlib.h"
@@ -38,14 +78,87 @@ team_t team = {
 
 #define WSIZE       4       /* Word and header/footer size (bytes) */  
 #define DSIZE       8       /* Double word size (bytes) */
-#define MINBLKSIZE  16      /* minimum block size with header and footer */  
+#define MINBLKSIZE  16      /* minimum block size with header, free pointers and footer */  
 #define CHUNKSIZE  (1<<12)  /* Extend heap by this amout (bytes) */
-#define ALIGNMENT   8       /* single word (4) or double word (8) alignment */
+#ifndef ALIGNMENT
+#define ALIGNMENT   8       /* double word (8) alignment, or 16 with -DALIGNMENT=16 */
+#endif
+
+/* Deferred coalescing */
+#ifndef DEFER_COALESCE
+#define DEFER_COALESCE  1               /* 0 : coalesce on every free */
+#endif
+#define QUICK_MAX       256             /* largest block size kept on a quick list */
+#define NUM_QUICK       ((QUICK_MAX - MINBLKSIZE) / DSIZE + 1)     /* one list per block size 16, 24, ... QUICK_MAX */
+#define DEFER_LIMIT     (1<<15)         /* flush the quick lists once they hold this many bytes */
+#define QUICK_INDEX(size)   (((size) - MINBLKSIZE) / DSIZE)
+#define QUICK_SIZE(i)       (MINBLKSIZE + (i) * DSIZE)
+
+/* Skip list over the address-ordered free list */
+#define SKIP_LEVELS     9               /* levels, counting the NEXT_FREE list as level 0; SKIP_LEVELS + 3 prologue words keep ALIGNMENT */
+#define SKIP(bp, i)     ((void *)((char *)(bp) + ((i) + 1) * WSIZE))   /* link word of level i >= 1, after NEXT_FREE and PREV_FREE */
+#define SKIP_CAP(size)  (((size) - 3*WSIZE) / WSIZE)                    /* levels a free block of size bytes can hold before its footer */
+
+/* Placement policy */
+#ifndef PLACE_SPLIT
+#define PLACE_SPLIT     96              /* blocks of at least this many bytes are carved from the high end until mm_set_place; 0 : all low */
+#endif
+#define PLACE_CLASSES   128             /* four classes per power of two, like TLSF's second level */
+#define PLACE_LOG2(size)    (31 - __builtin_clz((unsigned int)(size)))
+#define PLACE_CLASS(size)   ((PLACE_LOG2(size) << 2) | (((size) >> (PLACE_LOG2(size) - 2)) & 3))   /* size >= 4 */
+
+/* Headerless pages for tiny requests */
+#ifndef TINY_PAGES
+#define TINY_PAGES      1               /* 0 : tiny requests go to the heap like the rest */
+#endif
+#define TINY_PAGE       1024            /* bytes per tiny page, also its alignment; less than a VM page so a rarely used class wastes little */
+#define TINY_MAX        64              /* largest request served from a tiny page */
+#define NUM_TINY_CLASSES    6           /* slot sizes 8, 16, 24, 32, 48, 64 */
+#define TINY_MAP_WORDS  (TINY_PAGE / 8 / 32)    /* enough bits for the smallest slots */
+#define TINY_REGION_SIZE    (1<<20)     /* most bytes of tiny pages, taken off the top of region 0 */
+
+/* Lifetime-segregated region */
+#ifndef SHORT_REGION
+#define SHORT_REGION    0               /* 1 : blocks predicted to die young go to a region of their own; no trace gains from it yet */
+#endif
+#define SHORT_REGION_SIZE   (1<<20)     /* most bytes of the short-lived region, taken off the top of region 0 */
+#define LIFE_SHORT      64              /* a block freed within this many malloc/free calls of its birth lived short */
+#define LIFE_SLOTS      1024            /* birth table entries, a power of two; a block whose slot is taken again goes unsampled */
+#define LIFE_MAX_SIZE   1024            /* largest block sent to the short-lived region; a wrong guess on a bigger one strands a page there */
+#define LIFE_MAX        15              /* score ceiling per place class */
+#define LIFE_ON         8               /* classes scoring at least this are predicted short-lived */
+
+/* Allocation hints */
+#define NEAR_SPAN       4096            /* MALLOC_NEAR looks for room in the VM page of the near block */
+
+/* Heap growth */
+#ifndef GROW_MAX
+#define GROW_MAX        (1<<15)         /* largest step grow_heap takes when the tail block is allocated; CHUNKSIZE : fixed steps */
+#endif
+
+/* Capped fit search */
+#ifndef FIT_PROBES
+#define FIT_PROBES      0               /* most free blocks find_fit visits before giving up; 0 : no cap */
+#endif
+
+/* Heap trimming */
+#ifndef TRIM_THRESHOLD
+#define TRIM_THRESHOLD  (1<<16)         /* give a free tail block back to memlib once it is this large */
+#endif
+
+/* Direct mappings for large blocks */
+#ifndef MMAP_THRESHOLD
+#define MMAP_THRESHOLD  (1<<17)         /* requests of at least this many bytes get a mem_map mapping of their own */
+#endif
+#define MAPPED          0x4             /* header bit : block is a mapping, not part of the heap */
+#define MAP_SIZE(size)  (((size) + ALIGNMENT + mem_pagesize() - 1) & ~(mem_pagesize() - 1))   /* mapping bytes for a request */
 
 #define MAX(x, y) ((x) > (y)? (x) : (y))
+#define MIN(x, y) ((x) < (y)? (x) : (y))
 
-/* Pack a size and allocated bit into a word */
+/* Pack a size and allocated bits into a word */
 #define PACK(size, alloc)   ((size) | (alloc))
+#define PREV_ALLOC  0x2     /* header bit : previous block is allocated */
 
 /* Read and write a word at address p */
 #define GET(p) (*((unsigned int *)(p)))
@@ -54,64 +167,260 @@ team_t team = {
 /* Read the size and allocated fields from address p. (p would be an address of header or footer of block)*/
 #define GET_SIZE(p) (GET(p) & ~0x7)
 #define GET_ALLOC(p) (GET(p) & 0x1)
+#define GET_PREV_ALLOC(p) (GET(p) & PREV_ALLOC)
+#define GET_MAPPED(p) (GET(p) & MAPPED)
 #define UINT_CAST(p) ((size_t)p)
 
+/* Set or clear the PREV_ALLOC bit of the header at address p */
+#define SET_PREV_ALLOC(p)   PUT(p, GET(p) | PREV_ALLOC)
+#define CLR_PREV_ALLOC(p)   PUT(p, GET(p) & ~PREV_ALLOC)
+
 /* bp(block pointer) : payload의 시작 주소를 가리키는 포인터이다. 헤더를 가리키지 않는다. */
 /* Given block ptr bp(), compute address of its header and footer */
 #define HDRP(bp)        ((char *)(bp) - WSIZE)
-#define FTRP(bp)        ((char *)(bp) + GET_SIZE(HDRP(bp)) - DSIZE)
+#define FTRP(bp)        ((char *)(bp) + GET_SIZE(HDRP(bp)) - DSIZE)     // 가용 블록에만 footer가 있다.
 
 /* Given block ptr bp, compute address of next and previous blocks */
+/* PREV_BLKP 는 앞 블록의 footer를 읽으므로, GET_PREV_ALLOC 으로 앞 블록이 가용임을 확인한 뒤에만 쓸 수 있다. */
 #define NEXT_BLKP(bp)   ((char *)(bp) + GET_SIZE(((char *)(bp) - WSIZE)))
 #define PREV_BLKP(bp)   ((char *)(bp) - GET_SIZE(((char *)(bp) - DSIZE)))
 
 /* Given free block ptr bp, compute address of previous and next free blocks */
 #define NEXT_FREE(bp)   ((void *)((char *)bp))                
 #define PREV_FREE(bp)   ((void *)((char *)bp + WSIZE))
-// bp로부터 4바이트는 next free block의 주소값을 담고있다.
-// *(short **)bp
-// short라는 자료형에 대한 포인터이므로, bp주소에서 부터 short 자료형의 크기 2바이트를 읽는다.
-// *(void **)bp
-// 포인터(void*)라는 자료형에 대한 포인터(void**)이므로, bp주소에서 부터 포인터 자료형의 크기 4바이트(32bit mode)를 읽는다.
-// *(void **)(bp + WSIZE))
-// 포인터(void*)라는 자료형에 대한 포인터(void**)이므로, bp주소에서 부터 포인터 자료형의 크기 4바이트(32bit mode)를 읽는다.
+
+/* Read and write a free-list link at address p */
+// 링크는 포인터가 아니라 link_base 로부터의 32비트 offset 으로 한 워드(WSIZE)에 저장한다. 0 은 NULL 이다.
+// 64비트에서 포인터는 8바이트지만 링크는 그대로 4바이트이므로, MINBLKSIZE 는 16 bytes 로 유지된다.
+// link_base 는 힙 시작보다 한 워드 앞이라서, 힙 맨 앞의 root 도 0 이 아닌 offset 을 가진다.
+#define GET_LINK(p)         ((void *)(GET(p) ? link_base + GET(p) : NULL))
+#define PUT_LINK(p, ptr)    PUT(p, (ptr) ? (unsigned int)((char *)(ptr) - link_base) : 0)
 
 /* rounds up to the nearest multiple of ALIGNMENT */
-#define ALIGN(size) (((size) + (ALIGNMENT-1)) & ~0x7)       // 7을 더해주고 하위 3개의 비트는 0으로 바꿔줌.
-                                                            // 그러면 나보다 높으면서 가장 가까운 8의 배수가 될 수 있다.
+#define ALIGN(size) (((size) + (ALIGNMENT-1)) & ~(ALIGNMENT-1)) // ALIGNMENT-1 을 더해주고 하위 비트들을 0으로 바꿔줌.
+                                                                // 그러면 나보다 높으면서 가장 가까운 ALIGNMENT 의 배수가 될 수 있다.
+
+/* size class of a tiny request, and the page holding a slot */
+#define TINY_CLASS(size)    (tiny_class[((size) - 1) / 8])
+#define TINY_OF(bp)         ((tiny_t *)(UINT_CAST(bp) & ~(TINY_PAGE - 1)))
+#define TINY_SLOTS(t)       ((char *)(t) + TINY_HDRSIZE)
+#define TINY_HDRSIZE        ALIGN(sizeof(tiny_t))
+#define IS_TINY(bp)         (tiny_lo != NULL && (char *)(bp) >= tiny_lo && (char *)(bp) < tiny_lo + TINY_REGION_SIZE)
+
+/* whether bp lives in the short-lived region, the memlib region holding it, and the birth table slot of bp */
+#define IS_SHORT(bp)        (short_lo != NULL && (char *)(bp) >= short_lo && (char *)(bp) < short_lo + SHORT_REGION_SIZE)
+#define REGION_OF(bp)       (IS_SHORT(bp) ? short_region : 0)
+#define LIFE_SLOT(bp)       ((unsigned int)(UINT_CAST(bp) >> 3) * 2654435761u >> 22 & (LIFE_SLOTS - 1))
 
 /* heap checker */
 #ifdef DEBUG
 # define CHECKHEAP() printf("\n%s : %d\n", __func__,__LINE__); mm_checkheap(__LINE__);
 #endif
 
+/*
+ * tiny_t - tiny page 맨 앞의 metadata. slot 들은 TINY_HDRSIZE 부터 objsize 간격으로 놓인다.
+ */
+typedef struct tiny {
+    struct tiny *next, *prev;               /* partial list of its class, or empty_tiny */
+    unsigned short objsize;                 /* slot size (bytes) */
+    unsigned short nobjs;                   /* slots in the page */
+    unsigned short nfree;                   /* free slots */
+    unsigned short class;
+    unsigned int bitmap[TINY_MAP_WORDS];    /* bit i set : slot i is free */
+} tiny_t;
+
+/* slot size of each tiny class, and the class of a request by 8-byte step. With ALIGNMENT 16 only 16-byte multiples are used. */
+static const unsigned short tiny_size[NUM_TINY_CLASSES] = {8, 16, 24, 32, 48, 64};
+#if ALIGNMENT == 16
+static const unsigned char tiny_class[TINY_MAX / 8] = {1, 1, 3, 3, 4, 4, 5, 5};
+#else
+static const unsigned char tiny_class[TINY_MAX / 8] = {0, 1, 2, 3, 4, 4, 5, 5};
+#endif
+
 /* private variables */
 static char *heap_listp;
 static void *root;
+static char *link_base;                 /* free-list links are offsets from here */
+static char *tiny_lo;                   /* first byte of the tiny page region, NULL if there is none */
+static int tiny_region;
+static tiny_t *partial_tiny[NUM_TINY_CLASSES];  /* tiny pages with at least one free slot, per class */
+static tiny_t *empty_tiny;              /* tiny pages with every slot free, any class */
+
+/* tiny page counters, reset by mm_init */
+static struct {
+    int pages;      /* pages taken from the tiny region */
+    int allocs;     /* requests served from a tiny page */
+    int frees;      /* slots given back */
+    int spills;     /* tiny requests sent to the heap because the region was full */
+} tiny_stats;
+
+static char *short_lo;                  /* first byte of the short-lived region, NULL if there is none */
+static int short_region;
+
+/* lifetime predictor : a score per place class, learnt from the blocks sampled in the birth table */
+static unsigned char life_score[PLACE_CLASSES];
+static unsigned int life_clock;         /* malloc and free calls since mm_init */
+static struct {
+    void *bp;                           /* sampled block, NULL if the slot is empty */
+    unsigned int birth;                 /* life_clock when it was allocated */
+    unsigned char class;                /* its place class */
+} life_table[LIFE_SLOTS];
+
+static int life_hint;                   /* MALLOC_SHORT or MALLOC_LONG of the mm_malloc_flags call in progress, else 0 */
+
+/* lifetime counters, reset by mm_init */
+static struct {
+    int shorts;     /* mallocs predicted short-lived */
+    int samples;    /* frees whose birth was still in the table */
+    int young;      /* of those, blocks that lived short */
+    int flips;      /* times a class changed prediction */
+    int spills;     /* short-lived blocks sent to region 0 because the region was full */
+} life_stats;
+
+/* quick lists : singly linked through the NEXT_FREE word, headers still marked allocated */
+static void *quick[NUM_QUICK];
+static size_t quick_bytes;              /* bytes on all quick lists */
+
+/* deferred coalescing counters, reset by mm_init */
+static struct {
+    int hits;       /* mallocs served from a quick list */
+    int deferred;   /* frees put on a quick list */
+    int sized;      /* of those, through mm_free_sized */
+    int flushes;    /* batch coalesce passes */
+} quick_stats;
+
+/* mm_realloc path counters, reset by mm_init */
+static struct {
+    int shrink;     /* fits in the block itself */
+    int next;       /* grown into the next free block */
+    int extend;     /* grown at the heap tail by mem_sbrk */
+    int prev;       /* grown into the previous free block with memmove */
+    int copy;       /* fell back to malloc + memcpy + free */
+} realloc_stats;
+
+/* direct mapping counters, reset by mm_init */
+static struct {
+    int maps;       /* blocks given their own mapping */
+    int remaps;     /* reallocs served by mem_remap */
+    int unmaps;     /* mapped blocks freed */
+} map_stats;
+
+/* mm_memalign counters, reset by mm_init */
+static struct {
+    int calls;      /* requests with alignment above ALIGNMENT */
+    int leads;      /* leading fragments left on the free list */
+} align_stats;
+
+/* batch counters, reset by mm_init */
+static struct {
+    int carves;     /* mm_malloc_batch calls served by one split */
+    int blocks;     /* blocks handed out by those calls */
+    int frees;      /* blocks freed by mm_free_batch */
+    int runs;       /* address-contiguous runs they were freed as */
+} batch_stats;
+
+/* heap growth counters, reset by mm_init */
+static struct {
+    int extends;    /* times the heap was extended after mm_init */
+    int tails;      /* of those, extensions that only topped up a free tail block */
+    size_t bytes;   /* bytes added by them */
+} grow_stats;
+static size_t grow_step;                /* next grow_heap step when the tail block is allocated */
+
+/* find_fit counters, reset by mm_init */
+static struct {
+    int searches;   /* find_fit calls */
+    long probes;    /* free blocks visited by them */
+    int longest;    /* most free blocks visited by one call */
+    int capped;     /* calls stopped by FIT_PROBES */
+    int wraps;      /* next fit calls that went past the list tail back to the head */
+    size_t grown;   /* heap bytes mm_malloc added right after a capped call */
+} fit_stats;
+static int fit_capped;                  /* the last find_fit call was stopped by FIT_PROBES */
+static int fit_policy;                  /* FIT_FIRST or FIT_NEXT, set by mm_set_fit and kept across mm_init */
+static void *rover;                     /* next fit : free block the last search stopped at; NULL : the list head */
+
+/* placement rule per size class, set by mm_set_place and kept across mm_init */
+static unsigned char place_end[PLACE_CLASSES];
+static int place_set;                   /* mm_set_place was called; mm_init leaves place_end alone */
+
+/* placement counters, reset by mm_init */
+static struct {
+    int low;        /* blocks carved from the low end of a larger free block */
+    int high;       /* blocks carved from the high end */
+} place_stats;
+
+/* mm_malloc_flags counters, reset by mm_init */
+static struct {
+    int calls;      /* mm_malloc_flags calls */
+    int lives;      /* of those, with MALLOC_SHORT or MALLOC_LONG */
+    int nears;      /* with MALLOC_NEAR */
+    int adjacent;   /* placed right next to the near block, or in its tiny page */
+    int paged;      /* placed elsewhere in the near block's page */
+    int zeroed;     /* MALLOC_ZERO payloads cleared with memset */
+    int fresh;      /* MALLOC_ZERO payloads left alone because mem_map pages come zeroed */
+} hint_stats;
+
+/* heap trimming counters, reset by mm_init */
+static struct {
+    int trims;      /* free tail blocks given back */
+    size_t bytes;   /* bytes given back */
+} trim_stats;
 
 /* private function declarations */
 int mm_init(void);
-static void *extend_heap(size_t words);
-static void *find_fit(size_t asize);
+static void *extend_heap(int region, size_t words);
+static void *grow_heap(int region, size_t asize);
+static void *find_fit(size_t asize, int young);
 static void place(void *bp, size_t asize);
+static void *place_high(void *bp, size_t asize);
+static void *place_fit(void *bp, size_t asize);
+static void *near_block(size_t size, void *near);
 static void *coalesce(void *bp);
 static void update_pointer(void *bp, void *prev, void *next);
-static void *insert_free(void *bp);
+static void insert_free(void *bp);
+static void remove_free(void *bp);
+static void replace_free(void *old, void *new, size_t new_size);
+static void resize_free(void *bp, size_t size);
+static int skip_height(void *bp, size_t size);
+static void skip_search(void *bp, void **update);
+static size_t adjust_size(size_t size);
+static void absorb_next(void *bp);
+static void split_block(void *bp, size_t asize);
+static void free_block(void *bp);
+static void flush_quick(void);
+static void defer_block(void *bp, size_t size);
+static void trim_tail(void *bp);
+static void *map_block(size_t size);
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset);
+static void place_aligned(void *bp, char *p, size_t asize);
+static void *remap_block(void *bp, size_t size);
+static void carve_batch(char *bp, size_t asize, size_t n, void **out);
+static int compare_addr(const void *a, const void *b);
+static void *tiny_alloc(size_t size, tiny_t *want);
+static void tiny_free(void *bp);
+static tiny_t *tiny_new(int class);
+static void tiny_push(tiny_t **head, tiny_t *t);
+static void tiny_unlink(tiny_t **head, tiny_t *t);
+static int life_predict(size_t asize);
+static void *life_birth(void *bp, size_t asize);
+static void life_death(void *bp);
+static void life_move(void *old, void *bp);
 static void mm_checkheap(int lineno);
 
 /* 
  * mm_init - Initializes the heap like that shown below.
  -------------------------------------------------------------------------------------------------------------
  * <initialized heap image>
- * @                          @                           @  - double word alignment
- *  _____________ ____________ _____________ _____________
- * |   PROLOGUE  |  PROLOGUE  |   PROLOGUE  |             |
- * |     next    |    prev    |    footer   |   EPILOGUE  |
- * |-------------|------------|-------------|-------------|
- * |      0      |      0     |    4 / 1    |    0 / 1    |
- * |-------------|------------|-------------|-------------|
- *                                          ^
- *                                      heap_listp
+ * @                          @                                          @                           @  - double word alignment
+ *  _____________ ____________ ____________________________ _____________ _____________
+ * |   PROLOGUE  |  PROLOGUE  |          PROLOGUE          |   PROLOGUE  |             |
+ * |     next    |    prev    | skip 1 .. SKIP_LEVELS - 1  |    footer   |   EPILOGUE  |
+ * |-------------|------------|----------------------------|-------------|-------------|
+ * |      0      |      0     |          0 ... 0           |    4 / 1    |   0 / 1 1   |
+ * |-------------|------------|----------------------------|-------------|-------------|
+ *                                                                       ^
+ *                                                                   heap_listp
  -------------------------------------------------------------------------------------------------------------
  * <generalized heap image>
  * @                          @                           @                           @                           @  - double word alignment
@@ -124,22 +433,68 @@ static void mm_checkheap(int lineno);
  * ^                                        ^
  * root                                 heap_listp
  * 
- * 
+ * header 는 (size / PREV_ALLOC / alloc) 로 인코딩된다. 첫 번째 블록의 PREV_ALLOC 은 prologue 때문에 항상 1 이다.
+ * (generalized heap image 에서는 prologue 의 skip 링크를 생략했다. root 는 모든 층의 머리이다.)
  */
 int mm_init(void)
 {
+    int i;
+
     /* Create the initial empty heap */
-    if ((heap_listp = mem_sbrk(4*WSIZE)) == (void *)-1)     // 시스템에 요청한 heap공간 할당이 실패했을 때.
+    if ((heap_listp = mem_sbrk((SKIP_LEVELS + 3)*WSIZE)) == (void *)-1)     // 시스템에 요청한 heap공간 할당이 실패했을 때.
         return -1;
     PUT(heap_listp + 0*WSIZE, 0);                /* PROLOGUE next */
     PUT(heap_listp + 1*WSIZE, 0);                /* PROLOGUE prev */
-    PUT(heap_listp + 2*WSIZE, PACK(4, 1));       /* PROLOGUE footer */
-    PUT(heap_listp + 3*WSIZE, PACK(0, 1));       /* EPILOGUE */
+    for (i = 1; i < SKIP_LEVELS; i++)
+        PUT(SKIP(heap_listp, i), 0);             /* PROLOGUE skip links */
+    PUT(heap_listp + (SKIP_LEVELS + 1)*WSIZE, PACK(4, 1));       /* PROLOGUE footer */
+    PUT(heap_listp + (SKIP_LEVELS + 2)*WSIZE, PACK(0, PREV_ALLOC | 1));   /* EPILOGUE */
     root = heap_listp;
-    heap_listp += 3*WSIZE;
+    link_base = (char *)mem_heap_lo() - WSIZE;
+    heap_listp += (SKIP_LEVELS + 2)*WSIZE;
+    memset(&realloc_stats, 0, sizeof(realloc_stats));
+    memset(quick, 0, sizeof(quick));
+    quick_bytes = 0;
+    memset(&quick_stats, 0, sizeof(quick_stats));
+    memset(&trim_stats, 0, sizeof(trim_stats));
+    memset(&map_stats, 0, sizeof(map_stats));
+    memset(&align_stats, 0, sizeof(align_stats));
+    memset(&batch_stats, 0, sizeof(batch_stats));
+    memset(&fit_stats, 0, sizeof(fit_stats));
+    rover = NULL;
+    memset(&grow_stats, 0, sizeof(grow_stats));
+    memset(&place_stats, 0, sizeof(place_stats));
+    memset(&hint_stats, 0, sizeof(hint_stats));
+    if (!place_set) {
+        mm_set_place(0, PLACE_LOW);
+        if (PLACE_SPLIT)
+            mm_set_place(PLACE_SPLIT, PLACE_HIGH);
+        place_set = 0;
+    }
+    grow_step = CHUNKSIZE;
+
+    /* Carve the tiny page region. It starts on a page boundary, so TINY_OF works. */
+    memset(partial_tiny, 0, sizeof(partial_tiny));
+    memset(&tiny_stats, 0, sizeof(tiny_stats));
+    empty_tiny = NULL;
+    tiny_lo = NULL;
+    if (TINY_PAGES && (tiny_region = mem_region_new(TINY_REGION_SIZE)) >= 0)
+        tiny_lo = mem_region_lo(tiny_region);
+
+    /* Carve the short-lived region. It only holds padding and an epilogue until a young block needs room. */
+    memset(life_score, 0, sizeof(life_score));
+    memset(life_table, 0, sizeof(life_table));
+    memset(&life_stats, 0, sizeof(life_stats));
+    life_clock = 0;
+    short_lo = NULL;
+    if (SHORT_REGION && (short_region = mem_region_new(SHORT_REGION_SIZE)) >= 0) {
+        if ((short_lo = mem_region_sbrk(short_region, ALIGNMENT)) == (void *)-1)
+            return -1;
+        PUT(short_lo + ALIGNMENT - WSIZE, PACK(0, PREV_ALLOC | 1));     /* EPILOGUE, first payload lands on ALIGNMENT */
+    }
 
     /* Extend the empty heap with a free block of CHUNKSIZE bytes */
-    if (extend_heap(CHUNKSIZE/WSIZE) == NULL)   // 필요한 워드의 개수를 인자로 넘긴다.
+    if (extend_heap(0, CHUNKSIZE/WSIZE) == NULL)   // 필요한 워드의 개수를 인자로 넘긴다.
         return -1;
 
     return 0;
@@ -149,33 +504,71 @@ int mm_init(void)
  * extend_heap은
  * 1. 힙이 초기화 될 때, 또는
  * 2.mm_malloc이 적당한 맞춤 fit을 찾지 못했을 때 호출된다.
+ * region 0 이 원래의 힙이고, short_region 도 epilogue 가 있는 같은 모양이라 똑같이 늘린다.
  */
-static void *extend_heap(size_t words) // size_t a.k.a. {long, unsigned int} (stddef.h)
+static void *extend_heap(int region, size_t words) // size_t a.k.a. {long, unsigned int} (stddef.h)
 {
     char *bp;
     size_t size;
+    size_t prev_alloc;
 
-    /* Allocate an even number of words to maintain alignment */
-    size = (words % 2) ? (words+1) * WSIZE : words * WSIZE;     // 요청 크기를 2워드의 배수로 다시 맞춘다.
-    if ((long)(bp = mem_sbrk(size)) == -1)
+    /* Allocate a multiple of ALIGNMENT bytes to maintain alignment */
+    size = ALIGN(words * WSIZE);                                // 요청 크기를 ALIGNMENT 의 배수로 다시 맞춘다.
+    if ((long)(bp = mem_region_sbrk(region, size)) == -1)
         return NULL;
+    prev_alloc = GET_PREV_ALLOC(HDRP(bp));  // 이전 epilogue header 에 기록돼 있던 마지막 블록의 할당 여부
     /* Initialize free block header/footer and the epilogue header */
-    PUT(HDRP(bp), PACK(size, 0));           /* Free block header */     // 위에서 extend한 size가 encode 됨에 유의하자.
-    PUT(FTRP(bp), PACK(size, 0));           /* Free block footer */
-    PUT(HDRP(NEXT_BLKP(bp)), PACK(0,1));    /* New epilogue header */
+    PUT(HDRP(bp), PACK(size, prev_alloc));  /* Free block header */     // 위에서 extend한 size가 encode 됨에 유의하자.
+    PUT(FTRP(bp), GET(HDRP(bp)));           /* Free block footer */
+    PUT(HDRP(NEXT_BLKP(bp)), PACK(0,1));    /* New epilogue header */   // 앞 블록(방금 만든 블록)은 가용이다.
 
     /* Coalesce if the previous block was free block */
     return coalesce(bp);
 }
 
+/*
+ * grow_heap - asize 바이트 블록이 들어가는 가용 블록을 region 끝에 만들어서 돌려준다.
+ *           - 마지막 블록이 가용이면 모자란 만큼만 늘린다. extend_heap 이 그 블록과 합친다.
+ *             이미 충분히 크면 (find_fit 이 FIT_PROBES 때문에 거기까지 못 갔으면) 늘리지 않고 그 블록을 준다.
+ *           - 아니면 asize 와 grow_step 중 큰 만큼 늘리고, grow_step 을 GROW_MAX 까지 두 배로 키운다.
+ *             short_region 은 작은 블록이 금방 들어왔다 나가므로 asize 만큼만 늘리고, SHORT_REGION_SIZE 를 넘으면 NULL 이다.
+ */
+static void *grow_heap(int region, size_t asize)
+{
+    char *epilogue = (char *)mem_region_hi(region) + 1 - WSIZE;
+    size_t tail, size;
+
+    if (!GET_PREV_ALLOC(epilogue)) {
+        tail = GET_SIZE(epilogue - WSIZE);          // 마지막 가용 블록의 footer
+        if (tail >= asize)
+            return epilogue + WSIZE - tail;
+        size = asize - tail;
+        grow_stats.tails++;
+    }
+    else if (region != 0)
+        size = asize;
+    else {
+        size = MAX(asize, grow_step);
+        grow_step = MIN(grow_step * 2, GROW_MAX);
+    }
+    if (region != 0 && epilogue + WSIZE + size > short_lo + SHORT_REGION_SIZE)
+        return NULL;
+    grow_stats.extends++;
+    grow_stats.bytes += size;
+    return extend_heap(region, size/WSIZE);
+}
+
 /* 
  * mm_malloc - size 바이트의 메모리를 할당하고, 해당 블록의 포인터(bp)를 반환.
- *           - 적절한 크기의 free 블록을 찾지 못한 경우, extend_heap 을 통해 힙을 확장 후 할당.
+ *           - 적절한 크기의 free 블록을 찾지 못한 경우, grow_heap 을 통해 힙을 확장 후 할당.
+ *           - 찾은 블록의 어느 쪽에서 자를지는 place_fit 이 크기 클래스의 규칙대로 정한다. 새로 늘린 힙은 항상 앞에서 자른다.
+ *           - life_predict 가 금방 free 될 크기라고 하면 region 0 대신 short_region 에서 찾고 늘린다.
  */
 void *mm_malloc(size_t size)
 {
     size_t asize;       /* Adjusted block size for alignment */
-    size_t extendsize;  /* Amount to extend heap if no fit */
+    size_t grown;       /* grow_stats.bytes before growing the heap */
+    int young;          /* predicted to die young */
     char *bp;
 
     /* 불필요한 요청 무시 */
@@ -183,40 +576,359 @@ void *mm_malloc(size_t size)
         return NULL;
     }
 
+    /* 큰 요청은 힙을 조각내지 않도록 따로 mapping 을 받는다. */
+    if (size >= MMAP_THRESHOLD)
+        return map_block(size);
+
+    /* 아주 작은 요청은 header 없는 tiny page 에서 */
+    if (size <= TINY_MAX && (bp = tiny_alloc(size, NULL)) != NULL)
+        return bp;
+
     /* Adjust block size to include overhead and alignment reqs (double word). */
-    if (size <= MINBLKSIZE - DSIZE)     // 요청된 size가 minimum block size에서 header와 footer의 크기 뺀, 최소 payload크기보다도 작으면
-        asize = MINBLKSIZE;             // 그냥 minimum block을 할당해주면 됨.
-    else
-        asize = ALIGN(size) + DSIZE;    // size는 사용자가 요구한 공간. 거기에 헤더와 푸터의 8바이트를 더해줘야 한다.
+    asize = adjust_size(size);
+
+    /* 같은 크기의 블록이 quick list 에 있으면 그대로 준다. header 는 이미 할당 상태이다. */
+    /* (예측은 크기로 하므로 같은 크기의 블록은 보통 같은 region 에 있다.) */
+    if (DEFER_COALESCE && asize <= QUICK_MAX && (bp = quick[QUICK_INDEX(asize)]) != NULL) {
+        quick[QUICK_INDEX(asize)] = GET_LINK(NEXT_FREE(bp));
+        quick_bytes -= asize;
+        quick_stats.hits++;
+        return life_birth(bp, asize);
+    }
 
     /* Search the free list for a fit */
-    if ((bp = find_fit(asize)) != NULL) {
-        place(bp, asize);
+    young = life_predict(asize);
+    if ((bp = find_fit(asize, young)) != NULL)
+        return life_birth(place_fit(bp, asize), asize);
 
-        return bp;
+    /* 못 찾았으면 미뤄 둔 블록들을 합쳐 보고 다시 찾는다. */
+    if (DEFER_COALESCE && quick_bytes > 0) {
+        flush_quick();
+        if ((bp = find_fit(asize, young)) != NULL)
+            return life_birth(place_fit(bp, asize), asize);
     }
 
     /* No fit found. Get more memory and place the block */
-    extendsize = MAX(asize, CHUNKSIZE);
-    if ((bp = extend_heap(extendsize/WSIZE)) == NULL)
+    grown = grow_stats.bytes;
+    if (young && (bp = grow_heap(short_region, asize)) == NULL)
+        life_stats.spills++;            // short_region 이 다 찼으면 region 0 으로
+    if (bp == NULL && (bp = grow_heap(0, asize)) == NULL)
         return NULL;
+    if (fit_capped)                     // 상한 때문에 늘린 힙. 상한의 공간 비용이다.
+        fit_stats.grown += grow_stats.bytes - grown;
 
+    /* 남은 부분이 힙 끝에 남아야 다음 grow_heap 이 모자란 만큼만 늘린다. */
     place(bp, asize);
+    return life_birth(bp, asize);
+}
+
+/*
+ * mm_malloc_flags - 호출자가 아는 것 (flags) 을 같이 받는 mm_malloc.
+ *                 - MALLOC_SHORT / MALLOC_LONG : 예측 대신 그 수명으로 region 을 고른다. 둘 다 주면 힌트가 없는 것으로 본다.
+ *                 - MALLOC_NEAR : near 블록 바로 옆이나 같은 page 에 둔다. 자리가 없으면 보통의 mm_malloc 이다.
+ *                 - MALLOC_ZERO : payload 를 0 으로 채운다. mapping 블록은 mem_map 이 준 새 page 라서 이미 0 이므로 건너뛴다.
+ */
+void *mm_malloc_flags(size_t size, int flags, void *near)
+{
+    void *bp = NULL;
 
+    if (size == 0)
+        return NULL;
+    hint_stats.calls++;
+    if ((flags & MALLOC_NEAR) && near != NULL && size < MMAP_THRESHOLD) {
+        hint_stats.nears++;
+        bp = near_block(size, near);
+    }
+    if (bp == NULL) {
+        life_hint = flags & (MALLOC_SHORT | MALLOC_LONG);
+        if (life_hint == (MALLOC_SHORT | MALLOC_LONG))
+            life_hint = 0;
+        hint_stats.lives += life_hint != 0;
+        bp = mm_malloc(size);
+        life_hint = 0;
+    }
+    if (bp != NULL && (flags & MALLOC_ZERO)) {
+        if (size >= MMAP_THRESHOLD)
+            hint_stats.fresh++;
+        else {
+            memset(bp, 0, size);
+            hint_stats.zeroed++;
+        }
+    }
     return bp;
 }
 
+/*
+ * near_block - size 바이트 블록을 할당 블록 near 가까이에 만들어 준다. 자리가 없으면 NULL.
+ *            - near 가 tiny slot 이면 같은 클래스일 때 그 tiny page 에서 꺼낸다.
+ *            - 힙 블록이면 바로 뒤 가용 블록의 앞, 바로 앞 가용 블록의 뒤 순서로 보고, (그러면 두 블록이 이어진다)
+ *              그 다음에는 near 가 있는 NEAR_SPAN page 안에서 near 뒤의 가용 블록, 앞의 가용 블록 순서로 본다.
+ *              앞 블록은 뒤쪽에서 잘라서 near 에 가깝게 둔다. quick list 는 거치지 않는다.
+ */
+static void *near_block(size_t size, void *near)
+{
+    void *update[SKIP_LEVELS];
+    char *page = (char *)(UINT_CAST(near) & ~(size_t)(NEAR_SPAN - 1));
+    size_t asize;
+    char *bp;
+
+    if (IS_TINY(near)) {
+        if (size <= TINY_MAX && (bp = tiny_alloc(size, TINY_OF(near))) != NULL) {
+            hint_stats.paged += TINY_OF(bp) == TINY_OF(near);
+            return bp;
+        }
+        return NULL;
+    }
+    if (GET_MAPPED(HDRP(near)))                         // mapping 블록은 이웃이 없다.
+        return NULL;
+
+    asize = adjust_size(size);
+    bp = NEXT_BLKP(near);
+    if (!GET_ALLOC(HDRP(bp)) && GET_SIZE(HDRP(bp)) >= asize) {
+        hint_stats.adjacent++;
+        place(bp, asize);
+        return life_birth(bp, asize);
+    }
+    if (!GET_PREV_ALLOC(HDRP(near)) && GET_SIZE(HDRP(bp = PREV_BLKP(near))) >= asize) {
+        hint_stats.adjacent++;
+        return life_birth(place_high(bp, asize), asize);
+    }
+
+    skip_search(near, update);                          // update[0] : near 앞의 마지막 가용 블록
+    for (bp = GET_LINK(NEXT_FREE(update[0])); bp != NULL && bp < page + NEAR_SPAN; bp = GET_LINK(NEXT_FREE(bp)))
+        if (GET_SIZE(HDRP(bp)) >= asize) {
+            hint_stats.paged++;
+            place(bp, asize);
+            return life_birth(bp, asize);
+        }
+    bp = update[0];
+    if (bp != root && bp + GET_SIZE(HDRP(bp)) > page && GET_SIZE(HDRP(bp)) >= asize) {
+        hint_stats.paged++;
+        return life_birth(place_high(bp, asize), asize);
+    }
+    return NULL;
+}
+
+/*
+ * mm_memalign - payload 가 alignment 의 배수에 오는 블록을 준다. alignment 는 2의 거듭제곱이어야 한다.
+ */
+void *mm_memalign(size_t alignment, size_t size)
+{
+    return mm_memalign_offset(alignment, 0, size);
+}
+
+/*
+ * mm_memalign_offset - payload + offset 이 alignment 의 배수에 오는 블록을 준다. offset 은 ALIGNMENT 의 배수이다.
+ *                    - 가용 리스트를 first fit 으로 돌면서 그 자리에 payload 가 들어가는 블록을 찾는다.
+ *                    - 앞에 남는 조각은 최소 블록 이상일 때만 만들고, 그대로 가용 블록으로 남겨서 낭비하지 않는다.
+ *                    - 맞는 블록이 없으면 미뤄 둔 블록들을 합쳐 보고, 그래도 없으면 alignment 만큼 여유를 두고 힙을 늘린다.
+ */
+void *mm_memalign_offset(size_t alignment, size_t offset, size_t size)
+{
+    size_t asize;
+    char *p = NULL;
+    void *bp;
+
+    if (size == 0 || (alignment & (alignment - 1)) || offset % ALIGNMENT)
+        return NULL;
+    if (alignment <= ALIGNMENT)
+        return mm_malloc(size);
+
+    align_stats.calls++;
+    asize = adjust_size(size);
+    for (bp = GET_LINK(NEXT_FREE(root)); bp != NULL; bp = GET_LINK(NEXT_FREE(bp)))
+        if ((p = aligned_spot(bp, asize, alignment, offset)) != NULL)
+            break;
+
+    if (bp == NULL && DEFER_COALESCE && quick_bytes > 0) {
+        flush_quick();
+        for (bp = GET_LINK(NEXT_FREE(root)); bp != NULL; bp = GET_LINK(NEXT_FREE(bp)))
+            if ((p = aligned_spot(bp, asize, alignment, offset)) != NULL)
+                break;
+    }
+
+    if (bp == NULL) {       // 앞 조각 (MINBLKSIZE 이상, alignment 미만) 이 생겨도 asize 가 들어가도록 늘린다.
+        if ((bp = grow_heap(0, asize + alignment + MINBLKSIZE)) == NULL)
+            return NULL;
+        p = aligned_spot(bp, asize, alignment, offset);
+    }
+
+    place_aligned(bp, p, asize);
+    return p;
+}
+
+/*
+ * aligned_spot - 가용 블록 bp 안에서 asize 블록의 payload + offset 이 alignment 경계에 오는 가장 앞 자리를 돌려준다. 없으면 NULL.
+ *              - 앞에 남는 조각은 없거나 (p == bp) MINBLKSIZE 이상이어야 가용 블록이 될 수 있다.
+ */
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset)
+{
+    char *p = (char *)((((size_t)bp + offset + alignment - 1) & ~(alignment - 1)) - offset);
+
+    if (p != (char *)bp && p - (char *)bp < MINBLKSIZE)
+        p += alignment;
+    return p + asize <= (char *)bp + GET_SIZE(HDRP(bp)) ? p : NULL;
+}
+
+/*
+ * place_aligned - 가용 블록 bp 의 p 자리에 asize 블록을 할당한다.
+ *               - 앞 조각은 bp 주소에 그대로 남으므로 리스트 위치도 그대로이다. 줄어든 블록에 탑이 다 안 들어갈 수 있으므로 빼고 다시 넣는다.
+ *               - 뒤에 MINBLKSIZE 이상 남으면 가용 블록으로 떼어서 리스트에 넣는다.
+ */
+static void place_aligned(void *bp, char *p, size_t asize)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    size_t lead = p - (char *)bp;
+    size_t rest = size - lead;
+    void *trail;
+
+    if (lead == 0) {
+        place(bp, asize);
+        return;
+    }
+
+    align_stats.leads++;
+    remove_free(bp);
+    PUT(HDRP(bp), PACK(lead, GET_PREV_ALLOC(HDRP(bp))));   // 가용 블록의 앞 블록은 항상 할당 블록이다.
+    PUT(FTRP(bp), GET(HDRP(bp)));
+    insert_free(bp);
+
+    if (rest - asize >= MINBLKSIZE) {
+        PUT(HDRP(p), PACK(asize, 1));                       // 앞 조각이 가용이므로 PREV_ALLOC 은 끈다.
+        trail = NEXT_BLKP(p);
+        PUT(HDRP(trail), PACK(rest - asize, PREV_ALLOC));
+        PUT(FTRP(trail), GET(HDRP(trail)));
+        insert_free(trail);                                 // 뒤 블록의 PREV_ALLOC 은 원래대로 0 이다.
+    }
+    else {
+        PUT(HDRP(p), PACK(rest, 1));
+        SET_PREV_ALLOC(HDRP(NEXT_BLKP(p)));
+    }
+}
+
+/*
+ * mm_malloc_batch - size 바이트 블록 n 개를 할당해서 out 에 주소 순으로 채우고, 할당한 개수를 돌려준다.
+ *                 - n 개를 합친 크기의 가용 블록 하나를 찾아 place 로 한 번만 분할하고, 그 안을 잘라서 나눠 준다.
+ *                 - 그런 블록이 없으면 힙을 늘리지 않고 mm_malloc 을 하나씩 불러서, 흩어진 작은 가용 블록부터 쓴다.
+ *                   (batch 를 위해 힙을 늘리면 조각난 가용 공간을 두고 힙만 커진다.) 큰 요청도 하나씩 부른다.
+ *                 - tiny 크기라도 한 덩어리로 잘라 낼 수 있으면 힙에서 준다. 같이 할당된 블록은 같이 풀리는 일이 많아서 tiny page 를 조각내지 않는 편이 낫다.
+ *                 - 하나씩 부르다 힙을 늘릴 수 없으면 n 보다 적게 할당될 수 있다. asize * n 이 넘치는 n 도 하나씩 부른다.
+ */
+size_t mm_malloc_batch(size_t size, size_t n, void **out)
+{
+    size_t asize, total, i;
+    char *bp;
+
+    if (size == 0 || n == 0)
+        return 0;
+
+    asize = adjust_size(size);
+    if (size < MMAP_THRESHOLD && n > 1 && n <= SIZE_MAX / asize) {
+        total = asize * n;
+        if ((bp = find_fit(total, 0)) == NULL && DEFER_COALESCE && quick_bytes > 0) {
+            flush_quick();
+            bp = find_fit(total, 0);
+        }
+        if (bp != NULL) {
+            place(bp, total);
+            carve_batch(bp, asize, n, out);
+            return n;
+        }
+    }
+
+    for (i = 0; i < n; i++)
+        if ((out[i] = mm_malloc(size)) == NULL)
+            break;
+    return i;
+}
+
+/*
+ * carve_batch - place 로 할당한 블록 bp 를 asize 블록 n 개로 자른다. 할당 블록은 footer 가 없으므로 header 만 쓰면 된다.
+ *             - place 가 떼어 내지 못한 자투리 (MINBLKSIZE 미만) 는 마지막 블록이 갖는다.
+ */
+static void carve_batch(char *bp, size_t asize, size_t n, void **out)
+{
+    char *last = bp + (n - 1) * asize;
+    char *p;
+    size_t i;
+
+    PUT(HDRP(last), PACK(GET_SIZE(HDRP(bp)) - (n - 1) * asize, PREV_ALLOC | 1));
+    PUT(HDRP(bp), PACK(asize, GET_PREV_ALLOC(HDRP(bp)) | 1));
+    out[0] = bp;
+    for (i = 1, p = bp + asize; i < n - 1; i++, p += asize) {
+        PUT(HDRP(p), PACK(asize, PREV_ALLOC | 1));
+        out[i] = p;
+    }
+    out[n - 1] = last;
+    batch_stats.carves++;
+    batch_stats.blocks += n;
+}
+
+/*
+ * adjust_size - 요청 size 를 overhead 와 정렬을 포함한 블록 크기로 바꾼다.
+ */
+static size_t adjust_size(size_t size)
+{
+    if (size <= MINBLKSIZE - WSIZE)     // 요청된 size가 minimum block size에서 header의 크기 뺀, 최소 payload크기보다도 작으면
+        return MINBLKSIZE;              // 그냥 minimum block을 할당해주면 됨.
+    return ALIGN(size + WSIZE);         // size는 사용자가 요구한 공간. 할당 블록에는 footer가 없으므로 헤더 4바이트만 더해준다.
+}
+
 /*
  * find_fit - find available free block for request.
+ *          - first fit 은 리스트 머리부터, next fit 은 rover 부터 보고 끝에 닿으면 머리로 돌아와 rover 앞에서 멈춘다.
+ *          - FIT_PROBES 가 있으면 그만큼만 보고 NULL 을 돌려준다. 그때까지 본 블록 중 맞는 것은 없었다.
+ *          - 리스트는 주소 순이고 short_region 은 region 0 위에 있으므로, region 0 의 가용 블록이 모두 앞에 온다.
+ *            young 이 아니면 short_lo 에 닿을 때를 리스트 끝으로 보고, young 이면 short_lo 뒤의 첫 가용 블록부터 first fit 으로 본다.
 */
-static void *find_fit(size_t asize)
+static void *find_fit(size_t asize, int young)
 {   
-    // First-fit search
-    for (void *bp = (void *)GET(NEXT_FREE(root)); bp != NULL; bp = (void *)GET(NEXT_FREE(bp))) {
+    void *update[SKIP_LEVELS];
+    char *end = young ? NULL : short_lo;                // NULL : 리스트 끝까지
+    void *head, *start, *bp;
+    int probes = 0, wrapped = 0;
+
+    if (young) {
+        skip_search(short_lo, update);
+        head = GET_LINK(NEXT_FREE(update[0]));
+    }
+    else
+        head = GET_LINK(NEXT_FREE(root));
+    if (end != NULL && head != NULL && (char *)head >= end)
+        head = NULL;
+    start = head;
+    if (!young && fit_policy == FIT_NEXT && rover != NULL && (end == NULL || (char *)rover < end))
+        start = rover;
+    bp = start;
+
+    fit_capped = 0;
+    while (bp != NULL) {
+        if (FIT_PROBES && probes == FIT_PROBES) {
+            fit_capped = 1;
+            bp = NULL;
+            break;
+        }
+        probes++;
         if (GET_SIZE(HDRP(bp)) >= asize)
-            return bp;
+            break;
+        if ((bp = GET_LINK(NEXT_FREE(bp))) != NULL && end != NULL && (char *)bp >= end)
+            bp = NULL;                                  // short_region 은 이 요청의 리스트가 아니다.
+        if (bp == NULL && start != head && !wrapped) {
+            bp = head;                                  // next fit : 머리로 돌아간다.
+            wrapped = 1;
+        }
+        if (wrapped && bp == start)
+            bp = NULL;
     }
-    return NULL;
+    if (bp != NULL && !young && fit_policy == FIT_NEXT)
+        rover = bp;                                     // place 가 이 블록을 빼거나 나누면 rover 도 따라간다.
+
+    fit_stats.searches++;
+    fit_stats.wraps += wrapped;
+    fit_stats.probes += probes;
+    fit_stats.longest = MAX(fit_stats.longest, probes);
+    fit_stats.capped += fit_capped;
+    return bp;
 }
 
 /*
@@ -224,12 +936,12 @@ static void *find_fit(size_t asize)
 */
 static void update_pointer(void *bp, void *prev, void *next) {
     // 내 꺼
-    PUT(PREV_FREE(bp), prev);
-    PUT(NEXT_FREE(bp), next);
+    PUT_LINK(PREV_FREE(bp), prev);
+    PUT_LINK(NEXT_FREE(bp), next);
     // 남의 꺼  
-    PUT(NEXT_FREE(prev), bp);
+    PUT_LINK(NEXT_FREE(prev), bp);
     if (next)
-        PUT(PREV_FREE(next), bp);
+        PUT_LINK(PREV_FREE(next), bp);
 }
 
 /*
@@ -238,67 +950,397 @@ static void update_pointer(void *bp, void *prev, void *next) {
 static void place(void *bp, size_t asize)
 {
     size_t original_size = GET_SIZE(HDRP(bp));  // 원래 블록의 사이즈
+    size_t prev_alloc = GET_PREV_ALLOC(HDRP(bp));
     size_t diff = original_size - asize;
     
     if (diff >= MINBLKSIZE) {   // 원래 블록의 사이즈와 할당하려는 블록 사이즈의 차이가 블록의 최소크기 보다 커야 분할할 수 있다.
+        void * leftover_bp = (char *)bp + asize;
+
+        /* 포인터 조정 : header 가 bp 의 탑을 덮기 전에 남은 블록을 bp 자리에 넣는다. */
+        replace_free(bp, leftover_bp, diff);
 
         // 할당 처리
-        PUT(HDRP(bp) , PACK(asize, 1));             // header (asize / 1)
-        PUT(FTRP(bp) , PACK(asize, 1));             // footer (asize / 1)
-        void * leftover_bp = NEXT_BLKP(bp);
+        PUT(HDRP(bp) , PACK(asize, prev_alloc | 1));    // header (asize / prev_alloc / 1), footer 없음
         
         // 남은 부분 가용 처리
-        PUT(HDRP(leftover_bp), PACK(diff, 0));      // header (diff / 1)
-        PUT(FTRP(leftover_bp), PACK(diff, 0));      // footer (diff / 1)
-
-        /* 포인터 조정 */
-        update_pointer(leftover_bp, (void *)GET(PREV_FREE(bp)), (void *)GET(NEXT_FREE(bp)));
+        PUT(HDRP(leftover_bp), PACK(diff, PREV_ALLOC)); // header (diff / 1 / 0)
+        PUT(FTRP(leftover_bp), PACK(diff, PREV_ALLOC)); // footer (diff / 1 / 0)
     }
     else {  // 분할 못하는 경우.
 
         // 원래 블록을 전부 할당 처리.
-        PUT(FTRP(bp), PACK(original_size, 1));
-        PUT(HDRP(bp), PACK(original_size, 1));
+        PUT(HDRP(bp), PACK(original_size, prev_alloc | 1));
+        SET_PREV_ALLOC(HDRP(NEXT_BLKP(bp)));            // 뒤 블록에게 내가 할당됐음을 알린다.
 
         /* 포인터 조정 */
-        // 남의 꺼만 하면 됨. 어떠한 포인터도 날 가리키지 않게되면 나는 리스트에서 삭제된 것임.
-        PUT(NEXT_FREE(GET(PREV_FREE(bp))), GET(NEXT_FREE(bp)));
-        if (GET(NEXT_FREE(bp)))
-            PUT(PREV_FREE(GET(NEXT_FREE(bp))), GET(PREV_FREE(bp)));
+        remove_free(bp);
+    }
+}
+
+/*
+ * place_high - 가용 블록 bp 의 뒤쪽에 asize 블록을 할당하고 그 주소를 돌려준다.
+ *            - 남은 앞부분은 bp 자리에 그대로 있으므로 리스트 위치도 그대로이고, 크기만 줄인다.
+ *            - 남는 게 MINBLKSIZE 미만이면 나눌 수 없으므로 place 처럼 블록 전체를 준다.
+ */
+static void *place_high(void *bp, size_t asize)
+{
+    size_t diff = GET_SIZE(HDRP(bp)) - asize;
+    char *np;
+
+    if (diff < MINBLKSIZE) {
+        place(bp, asize);
+        return bp;
+    }
+
+    resize_free(bp, diff);
+    np = (char *)bp + diff;
+    PUT(HDRP(np), PACK(asize, 1));                      // 앞 블록이 가용이므로 PREV_ALLOC 은 끈다.
+    SET_PREV_ALLOC(HDRP(NEXT_BLKP(np)));
+    return np;
+}
+
+/*
+ * place_fit - asize 의 크기 클래스 규칙에 따라 가용 블록 bp 의 앞이나 뒤에 할당하고, 할당한 블록의 주소를 돌려준다.
+ */
+static void *place_fit(void *bp, size_t asize)
+{
+    if (GET_SIZE(HDRP(bp)) - asize < MINBLKSIZE) {      // 나누지 않으면 어느 쪽이든 같다.
+        place(bp, asize);
+        return bp;
+    }
+    if (place_end[PLACE_CLASS(asize)] == PLACE_HIGH) {
+        place_stats.high++;
+        return place_high(bp, asize);
+    }
+    place_stats.low++;
+    place(bp, asize);
+    return bp;
+}
+
+/*
+ * mm_set_place - size 가 속한 크기 클래스부터 위의 모든 클래스를 end (PLACE_LOW / PLACE_HIGH) 쪽에서 자르게 한다.
+ *              - 크기는 header 를 포함한 블록 크기이고, 클래스는 2의 거듭제곱 구간을 넷으로 나눈 것이다. (96 이면 96 ~ 111 부터)
+ *                size 가 MINBLKSIZE 보다 작으면 (0 이면) 모든 클래스이다.
+ *              - 작은 크기부터 차례로 부르면 구간마다 다른 규칙을 줄 수 있다. 한 번 부르고 나면 mm_init 은 규칙을 PLACE_SPLIT 으로 되돌리지 않는다.
+ */
+void mm_set_place(size_t size, int end)
+{
+    int i;
+
+    for (i = size >= MINBLKSIZE ? PLACE_CLASS(size) : 0; i < PLACE_CLASSES; i++)
+        place_end[i] = end;
+    place_set = 1;
+}
+
+/*
+ * mm_set_fit - find_fit 의 검색 방식을 정한다. FIT_FIRST 는 리스트 머리부터, FIT_NEXT 는 지난 검색이 멈춘 자리부터 찾는다.
+ *            - mm_init 은 검색 방식을 건드리지 않고 rover 만 지운다.
+ */
+void mm_set_fit(int policy)
+{
+    fit_policy = policy;
+    rover = NULL;
+}
+
+/*
+ * remove_free - 가용 블록 bp 를 리스트에서 뺀다. header 의 크기는 넣을 때 그대로여야 한다. (탑의 높이를 크기로 다시 구한다)
+ *             - 0 층은 PREV_FREE 가 있어서 바로 빠지고, 탑이 있으면 위층의 앞 블록을 찾아야 하므로 O(log n) 이다.
+ */
+static void remove_free(void *bp)
+{
+    void *update[SKIP_LEVELS];
+    int i, height = skip_height(bp, GET_SIZE(HDRP(bp)));
+
+    if (rover == bp)
+        rover = GET_LINK(NEXT_FREE(bp));                // 다음 검색은 bp 가 있던 자리 뒤에서 시작한다.
+    // 남의 꺼만 하면 됨. 어떠한 포인터도 날 가리키지 않게되면 나는 리스트에서 삭제된 것임.
+    PUT(NEXT_FREE(GET_LINK(PREV_FREE(bp))), GET(NEXT_FREE(bp)));  // 링크는 인코딩된 그대로 옮겨도 된다.
+    if (GET(NEXT_FREE(bp)))
+        PUT(PREV_FREE(GET_LINK(NEXT_FREE(bp))), GET(PREV_FREE(bp)));
+
+    if (height == 1)
+        return;
+    skip_search(bp, update);
+    for (i = 1; i < height; i++)
+        PUT(SKIP(update[i], i), GET(SKIP(bp, i)));
+}
+
+/*
+ * replace_free - 리스트에서 old 를 빼고 그 자리에 new_size 바이트짜리 new 를 넣는다. old 와 new 사이에 다른 가용 블록이 없어야 한다.
+ *              - 분할하고 남은 블록이나 뒤 블록을 흡수한 블록처럼, 두 블록이 겹칠 수 있다. 그래서 old 의 링크를 모두 읽은 뒤에 new 의 링크를 쓰고,
+ *                old 의 header 가 그대로일 때 (new 의 header 를 쓰기 전에) 불러야 한다.
+ *              - 둘 다 탑이 없으면 0 층만 바꾸면 되므로 O(1) 이다.
+ *              - rover 가 old 였으면 new 로 옮긴다.
+ */
+static void replace_free(void *old, void *new, size_t new_size)
+{
+    void *update[SKIP_LEVELS];
+    void *prev = GET_LINK(PREV_FREE(old));
+    void *next = GET_LINK(NEXT_FREE(old));
+    int i, old_height = skip_height(old, GET_SIZE(HDRP(old)));
+    int new_height = skip_height(new, new_size);
+
+    if (old_height > 1 || new_height > 1) {
+        skip_search(MIN(old, new), update);             // 두 블록 사이에 가용 블록이 없으므로 위층의 앞 블록도 같다.
+        for (i = 1; i < old_height; i++)
+            PUT(SKIP(update[i], i), GET(SKIP(old, i)));
+    }
+    update_pointer(new, prev, next);
+    if (rover == old)
+        rover = new;
+    for (i = 1; i < new_height; i++) {
+        PUT(SKIP(new, i), GET(SKIP(update[i], i)));
+        PUT_LINK(SKIP(update[i], i), new);
     }
 }
 
 /*
- * mm_free - 일단 현재 블록을 free해주고, coalese 를 통해 경우에 따라 인접한 블록들을 연결을 해준다.
+ * resize_free - 리스트에 있는 가용 블록 bp 의 크기를 제자리에서 size 로 바꾼다. 탑의 높이가 달라지면 빼고 다시 넣는다. rover 는 그대로 둔다.
+ */
+static void resize_free(void *bp, size_t size)
+{
+    int retower = skip_height(bp, GET_SIZE(HDRP(bp))) != skip_height(bp, size);
+    void *saved_rover = rover;
+
+    if (retower)
+        remove_free(bp);
+    PUT(HDRP(bp), PACK(size, PREV_ALLOC));      // 가용 블록의 앞 블록은 항상 할당 블록이다.
+    PUT(FTRP(bp), PACK(size, PREV_ALLOC));
+    if (retower) {
+        insert_free(bp);
+        rover = saved_rover;
+    }
+}
+
+/*
+ * skip_height - bp 자리에 있는 size 바이트 가용 블록의 탑 높이. (0 층 포함)
+ *             - 주소의 해시에서 두 비트씩 보면서 둘 다 0 이면 한 층 올린다. 높이를 저장하지 않아도 되도록 주소와 크기만으로 정한다.
+ */
+static int skip_height(void *bp, size_t size)
+{
+    unsigned int hash = (unsigned int)((char *)bp - link_base) * 2654435761u;  // Knuth multiplicative hash
+    int cap = MIN(SKIP_LEVELS, SKIP_CAP(size));
+    int height = 1;
+
+    for (hash >>= 16; height < cap && (hash & 3) == 0; hash >>= 2)
+        height++;
+    return height;
+}
+
+/*
+ * skip_search - 각 층에서 주소가 bp 보다 앞인 마지막 가용 블록을 update 에 채운다. 없으면 root 이다.
+ */
+static void skip_search(void *bp, void **update)
+{
+    void *x = root;
+    void *next;
+    int i;
+
+    for (i = SKIP_LEVELS - 1; i > 0; i--) {
+        while ((next = GET_LINK(SKIP(x, i))) != NULL && next < bp)
+            x = next;
+        update[i] = x;
+    }
+    while ((next = GET_LINK(NEXT_FREE(x))) != NULL && next < bp)
+        x = next;
+    update[0] = x;
+}
+
+/*
+ * mm_free - 작은 블록은 quick list 에 미뤄 두고, 나머지는 바로 free 해서 인접한 블록들과 연결한다.
  */
 void mm_free(void *bp)
+{
+    size_t size;
+
+    if (IS_TINY(bp)) {                  // tiny slot 에는 header 가 없으므로 먼저 본다.
+        tiny_free(bp);
+        return;
+    }
+    size = GET_SIZE(HDRP(bp));
+    if (GET_MAPPED(HDRP(bp))) {
+        map_stats.unmaps++;
+        mem_unmap((char *)bp - ALIGNMENT);
+        return;
+    }
+    life_death(bp);
+    if (DEFER_COALESCE && size <= QUICK_MAX) {
+        defer_block(bp, size);
+        return;
+    }
+    free_block(bp);
+}
+
+/*
+ * mm_free_sized - 호출자가 요청했던 크기 size 를 같이 알려 주는 mm_free.
+ *               - mapping 블록은 MMAP_THRESHOLD 이상 요청에만 생기므로, 그보다 작은 size 면 MAPPED bit 를 보지 않고 힙 블록으로 다룬다.
+ *               - list 는 header 의 실제 크기로 고른다. 분할되지 않은 블록은 adjust_size(size) 보다 클 수 있어서,
+ *                 size 로 고르면 남는 부분이 작은 list 에 숨고 quick_bytes 가 모자라게 센다.
+ *                 header 는 link 를 쓸 payload 바로 앞이라 같은 cache line 이다.
+ */
+void mm_free_sized(void *bp, size_t size)
+{
+    size_t bsize;
+
+    if (IS_TINY(bp)) {
+        tiny_free(bp);
+        return;
+    }
+    if (size >= MMAP_THRESHOLD) {
+        mm_free(bp);
+        return;
+    }
+    bsize = GET_SIZE(HDRP(bp));
+    life_death(bp);
+    if (DEFER_COALESCE && bsize <= QUICK_MAX) {
+        quick_stats.sized++;
+        defer_block(bp, bsize);
+        return;
+    }
+    free_block(bp);
+}
+
+/*
+ * mm_usable_size - bp 블록에서 실제로 쓸 수 있는 payload 바이트 수. 요청한 크기보다 클 수 있다.
+ */
+size_t mm_usable_size(void *bp)
+{
+    if (IS_TINY(bp))
+        return TINY_OF(bp)->objsize;
+    if (GET_MAPPED(HDRP(bp)))
+        return GET_SIZE(HDRP(bp)) - ALIGNMENT;
+    return GET_SIZE(HDRP(bp)) - WSIZE;          // 할당 블록은 footer 가 없다.
+}
+
+/*
+ * defer_block - 할당 상태 그대로 bp 를 size 바이트짜리 quick list 에 넣고, 너무 많이 쌓였으면 flush 한다.
+ */
+static void defer_block(void *bp, size_t size)
+{
+    PUT_LINK(NEXT_FREE(bp), quick[QUICK_INDEX(size)]);
+    quick[QUICK_INDEX(size)] = bp;
+    quick_bytes += size;
+    quick_stats.deferred++;
+    if (quick_bytes > DEFER_LIMIT)
+        flush_quick();
+}
+
+/*
+ * mm_free_batch - ptrs 의 블록 n 개를 free 한다. ptrs 배열은 주소 순으로 정렬된다.
+ *               - 정렬한 뒤 주소가 이어지는 블록들은 header 하나로 묶어서 free_block 을 run 당 한 번만 부른다.
+ *                 그래서 mm_malloc_batch 로 잘린 블록들은 coalesce 와 가용 리스트 삽입이 한 번에 끝난다.
+ *               - 한꺼번에 합쳐질 블록들이므로 quick list 를 거치지 않는다. mapping 블록과 tiny slot 은 mm_free 로 하나씩 돌려준다.
+ */
+void mm_free_batch(void **ptrs, size_t n)
+{
+    size_t i, j, size;
+    char *bp;
+
+    qsort(ptrs, n, sizeof(void *), compare_addr);
+    for (i = 0; i < n; i = j) {
+        bp = ptrs[i];
+        j = i + 1;
+        if (IS_TINY(bp) || GET_MAPPED(HDRP(bp))) {     // tiny region 은 힙 위에 있으므로 힙 블록의 run 에 끼지 않는다.
+            mm_free(bp);
+            continue;
+        }
+        life_death(bp);
+        size = GET_SIZE(HDRP(bp));
+        while (j < n && (char *)ptrs[j] == bp + size) {    // 바로 뒤 블록도 이번 batch 에 있으면 run 에 붙인다.
+            life_death(ptrs[j]);
+            size += GET_SIZE(HDRP(ptrs[j++]));
+        }
+        PUT(HDRP(bp), PACK(size, GET_PREV_ALLOC(HDRP(bp)) | 1));
+        free_block(bp);
+        batch_stats.runs++;
+    }
+    batch_stats.frees += n;
+}
+
+/*
+ * compare_addr - qsort 용. 두 블록 포인터를 주소 순으로 비교한다.
+ */
+static int compare_addr(const void *a, const void *b)
+{
+    char *p = *(char **)a;
+    char *q = *(char **)b;
+
+    return (p > q) - (p < q);
+}
+
+/*
+ * free_block - 일단 현재 블록을 free해주고, coalese 를 통해 경우에 따라 인접한 블록들을 연결을 해준다.
+ */
+static void free_block(void *bp)
 {
     size_t size = GET_SIZE(HDRP(bp));
-    PUT(HDRP(bp), PACK(size, 0));       // size 그대로인 free 블록으로 지정.
-    PUT(FTRP(bp), PACK(size, 0));       // size 그대로인 free 블록으로 지정.
-    coalesce(bp);
+    PUT(HDRP(bp), PACK(size, GET_PREV_ALLOC(HDRP(bp))));    // size 그대로인 free 블록으로 지정.
+    PUT(FTRP(bp), GET(HDRP(bp)));                           // 가용 블록이 되었으니 footer 도 써준다.
+    CLR_PREV_ALLOC(HDRP(NEXT_BLKP(bp)));                    // 뒤 블록에게 내가 가용이 되었음을 알린다.
+    trim_tail(coalesce(bp));
+}
 
+/*
+ * trim_tail - 가용 블록 bp 가 epilogue 바로 앞이고 TRIM_THRESHOLD 이상이면, 블록을 통째로 memlib 에 돌려준다.
+ *           - bp 의 header 자리가 새 epilogue 가 된다. 앞 블록은 할당 블록이므로 PREV_ALLOC 을 켠다.
+ *           - extend_heap 직후처럼 곧 쓸 블록에는 부르면 안 된다. free 경로에서만 부른다.
+ *           - bp 가 short_region 에 있으면 그 region 을 줄인다.
+ */
+static void trim_tail(void *bp)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    int region = REGION_OF(bp);
+
+    if (size < TRIM_THRESHOLD || GET_SIZE(HDRP(NEXT_BLKP(bp))) != 0)
+        return;
+    if (mem_region_sbrk(region, -(int)size) == (void *)-1)
+        return;
+    remove_free(bp);
+    PUT(HDRP(bp), PACK(0, PREV_ALLOC | 1));             /* New epilogue header */
+    if (region == 0)
+        grow_step = MAX(grow_step / 2, CHUNKSIZE);      // 수요가 줄었으니 다음 확장은 작게 한다.
+    trim_stats.trims++;
+    trim_stats.bytes += size;
+}
+
+/*
+ * flush_quick - quick list 의 블록을 모두 free_block 한다. (batch coalesce)
+ *             - 아직 quick list 에 남은 이웃은 할당 블록으로 보이므로 그때는 합쳐지지 않고, 그 이웃이 free_block 될 때 합쳐진다.
+ */
+static void flush_quick(void)
+{
+    void *bp;
+    int i;
 
+    for (i = 0; i < NUM_QUICK; i++) {
+        while ((bp = quick[i]) != NULL) {
+            quick[i] = GET_LINK(NEXT_FREE(bp));
+            free_block(bp);
+        }
+    }
+    quick_bytes = 0;
+    quick_stats.flushes++;
 }
 
 /*
  * insert_free - free된 블럭을 리스트 안에 삽입해야할 때 사용한다.
+ *             - skip list 의 위층부터 내려오면서 주소 순으로 들어갈 자리를 찾는다. O(log n)
 */
-static void *insert_free(void *bp) {
-    void * prev_free = root;
-    void * next_free = (void *)GET(NEXT_FREE(root));
-    while (next_free != NULL) {
-        if (bp < next_free)  // 찾았다!
-            break;
-        prev_free = next_free;
-        next_free = (void *)GET(NEXT_FREE(next_free));
+static void insert_free(void *bp) {
+    void *update[SKIP_LEVELS];
+    int i, height = skip_height(bp, GET_SIZE(HDRP(bp)));
+
+    skip_search(bp, update);
+    update_pointer(bp, update[0], GET_LINK(NEXT_FREE(update[0])));
+    for (i = 1; i < height; i++) {
+        PUT(SKIP(bp, i), GET(SKIP(update[i], i)));      // 링크는 인코딩된 그대로 옮겨도 된다.
+        PUT_LINK(SKIP(update[i], i), bp);
     }
-    update_pointer(bp, (void *)prev_free, (void *)next_free);
 }
 
 static void *coalesce(void *bp)
 {
-    size_t prev_alloc = GET_ALLOC(bp - DSIZE);              // 앞 블록의 할당 여부  // prologue에는 header가 없어서 이런 방식으로 계산.
+    size_t prev_alloc = GET_PREV_ALLOC(HDRP(bp));           // 앞 블록의 할당 여부  // 앞 블록의 footer 대신 내 header 의 비트를 본다.
     size_t next_alloc = GET_ALLOC(HDRP(NEXT_BLKP(bp)));     // 뒤 블록의 할당 여부
     size_t size = GET_SIZE(HDRP(bp));                       // 현재 블록의 사이즈
 
@@ -308,90 +1350,441 @@ static void *coalesce(void *bp)
     }
     /* case 3 : 앞 블록만 free 인 경우. */
     else if (next_alloc) {
-        size += GET_SIZE(HDRP(PREV_BLKP(bp)));
-        PUT(FTRP(bp), PACK(size, 0));
-        PUT(HDRP(PREV_BLKP(bp)), PACK(size, 0));
         bp = PREV_BLKP(bp);
-        // prev free block은 이미 free list에 있던 블록이기 때문에,
-        // update_pointer 불필요.
+        // prev free block은 이미 free list에 있던 블록이기 때문에, 제자리에서 키운다.
+        resize_free(bp, size + GET_SIZE(HDRP(bp)));
     }
     /* case 2 : 뒤 블록만 free 인 경우. */
     else if (prev_alloc) {
         void * next_bp = NEXT_BLKP(bp);
         size += GET_SIZE(HDRP(next_bp));
-        PUT(HDRP(bp), PACK(size, 0));           // 현재 블록의 크기와 뒤 블록의 크기가 합쳐진 size가 현재 블록의 header에 인코딩됨.
-        PUT(FTRP(bp), PACK(size, 0));           // 위 라인 덕분에 FTRP(bp) 는 다음 블록의 footer를 가리키게 된다.
-
-        update_pointer(bp, (void *)GET(PREV_FREE(next_bp)), (void *)GET(NEXT_FREE(next_bp)));
+        replace_free(next_bp, bp, size);        // 뒤 블록의 header 와 링크가 그대로일 때 그 자리를 물려받는다.
+        PUT(HDRP(bp), PACK(size, PREV_ALLOC));  // 현재 블록의 크기와 뒤 블록의 크기가 합쳐진 size가 현재 블록의 header에 인코딩됨.
+        PUT(FTRP(bp), PACK(size, PREV_ALLOC));  // 위 라인 덕분에 FTRP(bp) 는 다음 블록의 footer를 가리키게 된다.
     }
 
     /* case 4 : 앞, 뒤 블록 모두 free 인 경우. */
     else {
-        size += GET_SIZE(HDRP(PREV_BLKP(bp))) + GET_SIZE(FTRP(NEXT_BLKP(bp)));
-        PUT(HDRP(PREV_BLKP(bp)), PACK(size, 0));
-        PUT(FTRP(NEXT_BLKP(bp)), PACK(size, 0));
-        void *nnext_bp = NEXT_BLKP(bp); 
+        void *next_bp = NEXT_BLKP(bp);
+        size += GET_SIZE(HDRP(next_bp));
+        remove_free(next_bp);
         bp = PREV_BLKP(bp);
-
-        update_pointer(bp, (void *)GET(PREV_FREE(bp)), (void *)GET(NEXT_FREE(nnext_bp)));
+        resize_free(bp, size + GET_SIZE(HDRP(bp)));
     }
     return bp;
 }
 
 /*
- * mm_realloc - Implemented simply in terms of mm_malloc and mm_free
+ * map_block - size 바이트 요청에 mem_map 으로 페이지 단위 mapping 을 따로 만들어 준다.
+ *
+ *   mapping 시작 (페이지 경계)
+ *   v
+ *   +---------+--------+------------------------------------+
+ *   | padding | header |  payload                           |
+ *   +---------+--------+------------------------------------+
+ *                      ^
+ *                      bp = 시작 + ALIGNMENT
+ *
+ * header 는 (mapping 크기 / MAPPED / 1) 이다. mapping 블록은 가용 리스트에 들어가지 않고, 힙의 이웃도 없다.
+ */
+static void *map_block(size_t size)
+{
+    size_t msize = MAP_SIZE(size);
+    char *p;
+
+    if ((p = mem_map(msize)) == (void *)-1)
+        return NULL;
+    map_stats.maps++;
+    PUT(p + ALIGNMENT - WSIZE, PACK(msize, MAPPED | 1));
+    return p + ALIGNMENT;
+}
+
+/*
+ * remap_block - mapping 블록의 realloc. 여전히 큰 요청이면 mem_remap 으로 페이지를 늘리거나 줄이고 (복사 없음),
+ *               MMAP_THRESHOLD 아래로 줄면 힙 블록으로 옮긴다.
+ */
+static void *remap_block(void *bp, size_t size)
+{
+    size_t old_size = GET_SIZE(HDRP(bp));
+    size_t msize = MAP_SIZE(size);
+    char *p;
+
+    if (size < MMAP_THRESHOLD) {
+        if ((p = mm_malloc(size)) == NULL)
+            return NULL;
+        memcpy(p, bp, size);                    // size 는 mapping 의 payload 보다 작다.
+        life_move(bp, p);
+        mm_free(bp);
+        return p;
+    }
+    if (msize == old_size)
+        return bp;
+    if ((p = mem_remap((char *)bp - ALIGNMENT, msize)) == (void *)-1)
+        return NULL;
+    map_stats.remaps++;
+    PUT(p + ALIGNMENT - WSIZE, PACK(msize, MAPPED | 1));
+    return p + ALIGNMENT;
+}
+
+/*
+ * mm_realloc - 가능하면 블록을 제자리에서 늘리거나 줄이고, 안 될 때만 mm_malloc + memcpy + mm_free 를 한다.
+ *            - 다음 순서로 시도한다.
+ *              1. 줄이기       : 요청이 지금 블록에 들어가면 남는 부분만 잘라서 가용 리스트로 돌려준다.
+ *              2. 뒤 블록 흡수  : 뒤 블록이 가용이고 합친 크기가 충분하면 뒤 블록을 흡수한다.
+ *              3. 힙 끝 확장    : 내가 (뒤의 가용 블록을 포함해서) epilogue 바로 앞 블록이면 모자란 만큼만 내 region 을 늘린다.
+ *              4. 앞 블록 흡수  : 앞 블록이 가용이고 (뒤 블록까지) 합친 크기가 충분하면, 앞으로 payload 를 memmove 한다.
+ *              5. 복사         : 위가 모두 안 되면 새로 할당해서 복사한다.
+ *            - 각 경로를 탄 횟수는 realloc_stats 에 세고, mm_report 로 출력한다.
+ *            - mapping 블록은 힙의 이웃이 없으므로 remap_block 이 따로 맡는다. tiny slot 은 들어가면 그대로 두고 아니면 복사한다.
  */
 void *mm_realloc(void *bp, size_t size)
 {
-    void *oldptr = bp;
     void *newptr;
+    void *next_bp, *prev_bp;
+    size_t asize;
+    size_t old_size, next_size, prev_size;
     size_t copySize;
-    
+
+    if (bp == NULL)
+        return mm_malloc(size);
+    if (size == 0) {
+        mm_free(bp);
+        return NULL;
+    }
+    /* tiny slot 은 늘릴 수 없다. 들어가면 그대로, 아니면 옮긴다. */
+    if (IS_TINY(bp)) {
+        copySize = TINY_OF(bp)->objsize;
+        if (size <= copySize) {
+            realloc_stats.shrink++;
+            return bp;
+        }
+        realloc_stats.copy++;
+        if ((newptr = mm_malloc(size)) == NULL)
+            return NULL;
+        memcpy(newptr, bp, copySize);
+        life_move(bp, newptr);
+        tiny_free(bp);
+        return newptr;
+    }
+    if (GET_MAPPED(HDRP(bp)))
+        return remap_block(bp, size);
+
+    asize = adjust_size(size);
+    old_size = GET_SIZE(HDRP(bp));
+    next_bp = NEXT_BLKP(bp);
+    next_size = GET_ALLOC(HDRP(next_bp)) ? 0 : GET_SIZE(HDRP(next_bp));    // 뒤 블록이 가용일 때만 쓸 수 있는 크기
+
+    /* 1. 줄이기 (또는 그대로) */
+    if (asize <= old_size) {
+        realloc_stats.shrink++;
+        split_block(bp, asize);
+        return bp;
+    }
+
+    /* 2. 뒤 블록 흡수 */
+    if (old_size + next_size >= asize) {
+        realloc_stats.next++;
+        absorb_next(bp);
+        split_block(bp, asize);
+        return bp;
+    }
+
+    /* 3. 힙 끝 확장 */
+    if (GET_SIZE(HDRP(next_size ? NEXT_BLKP(next_bp) : next_bp)) == 0) {     // 그 다음이 epilogue 이다.
+        size_t extendsize = asize - old_size - next_size;
+
+        if ((!IS_SHORT(bp) || (char *)mem_region_hi(short_region) + 1 + extendsize <= short_lo + SHORT_REGION_SIZE)
+            && mem_region_sbrk(REGION_OF(bp), extendsize) != (void *)-1) {
+            realloc_stats.extend++;
+            grow_stats.extends++;
+            grow_stats.tails++;                 // 할당 블록이지만 힙 끝이므로 모자란 만큼만 늘렸다.
+            grow_stats.bytes += extendsize;
+            if (next_size)
+                absorb_next(bp);
+            PUT(HDRP(bp), PACK(asize, GET_PREV_ALLOC(HDRP(bp)) | 1));
+            PUT(HDRP(NEXT_BLKP(bp)), PACK(0, PREV_ALLOC | 1));          /* New epilogue header */
+            return bp;
+        }
+    }
+
+    /* 4. 앞 블록 흡수 */
+    prev_size = GET_PREV_ALLOC(HDRP(bp)) ? 0 : GET_SIZE(bp - DSIZE);      // 앞 블록이 가용이면 footer 에서 크기를 읽는다.
+    if (prev_size + old_size + next_size >= asize) {
+        size_t total = prev_size + old_size;
+
+        realloc_stats.prev++;
+        prev_bp = PREV_BLKP(bp);
+        if (prev_size + old_size < asize) {     // 앞 블록만으로 모자라면 뒤 블록까지 흡수한다.
+            remove_free(next_bp);
+            total += next_size;
+        }
+        remove_free(prev_bp);                   // 리스트 포인터가 덮어써지기 전에 먼저 뺀다.
+        PUT(HDRP(prev_bp), PACK(total, GET_PREV_ALLOC(HDRP(prev_bp)) | 1));
+        memmove(prev_bp, bp, old_size - WSIZE);
+        life_move(bp, prev_bp);
+        SET_PREV_ALLOC(HDRP(NEXT_BLKP(prev_bp)));
+        split_block(prev_bp, asize);
+        return prev_bp;
+    }
+
+    /* 5. 복사 */
+    realloc_stats.copy++;
     newptr = mm_malloc(size);       // size : 사용자 요청 크기
     if (newptr == NULL)
       return NULL;
-    copySize = GET_SIZE(HDRP(oldptr)) - DSIZE;
+    copySize = old_size - WSIZE;    // 할당 블록의 payload 는 header 를 뺀 나머지 전부.
     if (size < copySize)
       copySize = size;
-    memcpy(newptr, oldptr, copySize);
+    memcpy(newptr, bp, copySize);
+    life_move(bp, newptr);
 
-    mm_free(oldptr);
+    mm_free(bp);
     return newptr;
+}
 
-    // size_t block_size = GET_SIZE(HDRP(bp));
-    // // 1. 재요청된 size가 원래 payload size보다 작거나 같을 때.
-    // if (size <= (block_size - DSIZE)) {
-    //     size_t al_blk_size;
-    //     if (size <= MINBLKSIZE - DSIZE)
-    //         { al_blk_size = MINBLKSIZE; }
-    //     else
-    //         { al_blk_size = ALIGN(size) + DSIZE; }
-
-    //     // 1-1. 원래 블록이 분할 가능할 때.
-    //     if (block_size - al_blk_size >= MINBLKSIZE) {
-    //         // 할당 처리
-    //         PUT(HDRP(bp) , PACK(al_blk_size, 1));             // header (al_blk_size / 1)
-    //         PUT(FTRP(bp) , PACK(al_blk_size, 1));             // footer (al_blk_size / 1)
-            
-    //         // 남은 부분 가용 처리
-    //         void * leftover_bp = NEXT_BLKP(bp);
-    //         PUT(HDRP(leftover_bp), PACK(block_size - al_blk_size, 0));     // header (diff / 1)
-    //         PUT(FTRP(leftover_bp), PACK(block_size - al_blk_size, 0));     // footer (diff / 1)
-            
-    //         coalesce(leftover_bp);
-    //     }
-    //     // 1-2. 원래 블록이 분할 불가능할 때.
-    //     // -> 아무 것도 할 수 있는게 없다. 그냥 그대로 돌려주면 됨.
-    // }
-    // // 2. 재요청된 size가 원래 size보다 클 때.
-    // else {
-    //     void *new_bp = mm_malloc(size);
-    //     memcpy(new_bp, bp, block_size);
-    //     mm_free(bp);
-    //     bp = new_bp;
-    // }
-    
-    // return bp;
+/*
+ * absorb_next - 할당 블록 bp 뒤의 가용 블록을 리스트에서 빼고 bp 에 합친다.
+ */
+static void absorb_next(void *bp)
+{
+    void *next_bp = NEXT_BLKP(bp);
+    size_t size = GET_SIZE(HDRP(bp)) + GET_SIZE(HDRP(next_bp));
+
+    remove_free(next_bp);
+    PUT(HDRP(bp), PACK(size, GET_PREV_ALLOC(HDRP(bp)) | 1));
+    SET_PREV_ALLOC(HDRP(NEXT_BLKP(bp)));        // 가용 블록의 뒤 블록이었으니 PREV_ALLOC 이 꺼져 있었다.
+}
+
+/*
+ * split_block - 할당 블록 bp 를 asize 로 줄이고, 남는 부분이 최소 블록 이상이면 가용 블록으로 돌려준다.
+ */
+static void split_block(void *bp, size_t asize)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    size_t diff = size - asize;
+    void *leftover_bp;
+
+    if (diff < MINBLKSIZE)
+        return;
+
+    PUT(HDRP(bp), PACK(asize, GET_PREV_ALLOC(HDRP(bp)) | 1));
+    leftover_bp = NEXT_BLKP(bp);
+    PUT(HDRP(leftover_bp), PACK(diff, PREV_ALLOC));
+    PUT(FTRP(leftover_bp), PACK(diff, PREV_ALLOC));
+    CLR_PREV_ALLOC(HDRP(NEXT_BLKP(leftover_bp)));
+    trim_tail(coalesce(leftover_bp));           // 뒤 블록이 가용이면 합쳐지고, 힙 끝이면 잘려 나간다.
+}
+
+/*
+ * tiny_alloc - size 가 속한 클래스의 tiny page 에서 가용 slot 하나를 꺼낸다. tiny page 가 없거나 region 이 다 찼으면 NULL.
+ *            - want 가 같은 클래스이고 가용 slot 이 있으면 그 page 에서 꺼낸다. (MALLOC_NEAR)
+ */
+static void *tiny_alloc(size_t size, tiny_t *want)
+{
+    int class = TINY_CLASS(size);
+    tiny_t *t = partial_tiny[class];
+    int i, bit;
+
+    if (tiny_lo == NULL)
+        return NULL;
+    if (want != NULL && want->class == class && want->nfree > 0)
+        t = want;                           // 살아 있는 slot 이 있는 page 이므로 partial 에 있다.
+    if (t == NULL) {
+        if ((t = tiny_new(class)) == NULL) {
+            tiny_stats.spills++;
+            return NULL;
+        }
+        tiny_push(&partial_tiny[class], t);
+    }
+
+    for (i = 0; t->bitmap[i] == 0; i++)     // partial 에 있는 page 는 가용 slot 이 반드시 있다.
+        ;
+    bit = __builtin_ctz(t->bitmap[i]);
+    t->bitmap[i] &= ~(1u << bit);
+    if (--t->nfree == 0)                    // 다 찼으면 partial 에서 뺀다.
+        tiny_unlink(&partial_tiny[class], t);
+    tiny_stats.allocs++;
+    return TINY_SLOTS(t) + (i * 32 + bit) * t->objsize;
+}
+
+/*
+ * tiny_free - slot 을 bitmap 에 돌려준다. 페이지 경계로 내림한 주소가 그 slot 의 tiny_t 이다.
+ */
+static void tiny_free(void *bp)
+{
+    tiny_t *t = TINY_OF(bp);
+    int idx = ((char *)bp - TINY_SLOTS(t)) / t->objsize;
+
+    t->bitmap[idx / 32] |= 1u << (idx % 32);
+    if (t->nfree++ == 0)                    // 꽉 차 있었으면 다시 partial 로.
+        tiny_push(&partial_tiny[t->class], t);
+    if (t->nfree == t->nobjs) {             // 다 비었으면 다른 클래스도 쓸 수 있게 empty_tiny 로.
+        tiny_unlink(&partial_tiny[t->class], t);
+        tiny_push(&empty_tiny, t);
+    }
+    tiny_stats.frees++;
+}
+
+/*
+ * tiny_new - 빈 tiny page 를 하나 가져와 class 의 slot 들로 나눈다. empty_tiny 에 없으면 region 에서 한 페이지 떼어 온다.
+ */
+static tiny_t *tiny_new(int class)
+{
+    tiny_t *t;
+    int n;
+
+    if ((t = empty_tiny) != NULL)
+        tiny_unlink(&empty_tiny, t);
+    else {
+        if ((char *)mem_region_hi(tiny_region) + 1 + TINY_PAGE > tiny_lo + TINY_REGION_SIZE)
+            return NULL;    // region 이 다 찼다.
+        t = mem_region_sbrk(tiny_region, TINY_PAGE);
+        tiny_stats.pages++;
+    }
+
+    t->class = class;
+    t->objsize = tiny_size[class];
+    t->nobjs = t->nfree = (TINY_PAGE - TINY_HDRSIZE) / t->objsize;
+    memset(t->bitmap, 0, sizeof(t->bitmap));
+    for (n = 0; n + 32 <= t->nobjs; n += 32)
+        t->bitmap[n / 32] = ~0u;
+    if (n < t->nobjs)
+        t->bitmap[n / 32] = (1u << (t->nobjs - n)) - 1;
+    return t;
+}
+
+/*
+ * tiny_push, tiny_unlink - tiny page 이중 연결 리스트의 맨 앞에 넣기, 아무 데서나 빼기.
+ */
+static void tiny_push(tiny_t **head, tiny_t *t)
+{
+    t->prev = NULL;
+    t->next = *head;
+    if (*head)
+        (*head)->prev = t;
+    *head = t;
+}
+
+static void tiny_unlink(tiny_t **head, tiny_t *t)
+{
+    if (t->prev)
+        t->prev->next = t->next;
+    else
+        *head = t->next;
+    if (t->next)
+        t->next->prev = t->prev;
+}
+
+/*
+ * life_predict - asize 블록이 금방 free 될 것 같으면 1. short_region 이 없으면 언제나 0 이다.
+ *              - place class 마다 점수를 두고, 표본 블록이 LIFE_SHORT 안에 free 되면 1 올리고 그보다 오래 살았으면 2 내린다.
+ *                그래서 표본의 2/3 넘게 일찍 죽는 클래스만 LIFE_ON 까지 올라간다. 처음에는 모두 0 (오래 삶) 이다.
+ *              - 호출자가 mm_malloc_flags 로 수명을 알려 줬으면 (life_hint) 점수 대신 그대로 따른다. 크기 제한도 없다.
+ */
+static int life_predict(size_t asize)
+{
+    int young;
+
+    if (life_hint)
+        young = short_lo != NULL && life_hint == MALLOC_SHORT;
+    else
+        young = short_lo != NULL && asize <= LIFE_MAX_SIZE && life_score[PLACE_CLASS(asize)] >= LIFE_ON;
+
+    life_stats.shorts += young;
+    return young;
+}
+
+/*
+ * life_birth - 방금 할당한 블록 bp 의 태어난 시각을 birth table 에 적고 bp 를 돌려준다.
+ *            - table 은 주소로 고르는 direct-mapped 이다. 자리에 다른 블록이 있으면 덮어쓰고, 그 블록은 표본에서 빠진다.
+ */
+static void *life_birth(void *bp, size_t asize)
+{
+    int slot = LIFE_SLOT(bp);
+
+    life_table[slot].bp = bp;
+    life_table[slot].birth = life_clock++;
+    life_table[slot].class = PLACE_CLASS(asize);
+    return bp;
+}
+
+/*
+ * life_death - free 되는 블록 bp 가 birth table 에 있으면 얼마나 살았는지로 그 클래스의 점수를 고친다.
+ */
+static void life_death(void *bp)
+{
+    int slot = LIFE_SLOT(bp);
+    int class = life_table[slot].class;
+    int was = life_score[class] >= LIFE_ON;
+
+    life_clock++;
+    if (life_table[slot].bp != bp)
+        return;
+    life_table[slot].bp = NULL;
+    life_stats.samples++;
+    if (life_clock - life_table[slot].birth <= LIFE_SHORT) {
+        life_stats.young++;
+        life_score[class] = MIN(life_score[class] + 1, LIFE_MAX);
+    }
+    else
+        life_score[class] = MAX(life_score[class] - 2, 0);
+    life_stats.flips += was != (life_score[class] >= LIFE_ON);
+}
+
+/*
+ * life_move - mm_realloc 이 블록을 old 에서 bp 로 옮겼다. old 의 table 자리를 비우고, 태어난 시각과 클래스는 bp 의 자리로 옮긴다.
+ *           - 옮기는 것은 죽음이 아니므로 점수를 고치지 않고 life_clock 도 세지 않는다. 뒤따르는 mm_free(old) 는 table 에서 old 를 못 찾는다.
+ *           - old 가 표본이 아니었으면 mm_malloc 이 bp 에 적은 시각도 지운다. realloc 한 시각을 태어난 시각으로 치면 수명이 짧게 잡힌다.
+ */
+static void life_move(void *old, void *bp)
+{
+    int from = LIFE_SLOT(old), to = LIFE_SLOT(bp);
+
+    if (life_table[from].bp != old) {
+        if (life_table[to].bp == bp)
+            life_table[to].bp = NULL;
+        return;
+    }
+    life_table[to] = life_table[from];
+    life_table[to].bp = bp;
+    if (from != to)
+        life_table[from].bp = NULL;
+}
+
+/*
+ * mm_report - print tiny page usage, lifetime predictions, quick list traffic, batch traffic, placement, hints and how often each mm_realloc path was taken since mm_init.
+ */
+void mm_report(void)
+{
+    printf("tiny: %d pages, %d allocs, %d frees, %d spilled to the heap\n",
+           tiny_stats.pages, tiny_stats.allocs, tiny_stats.frees, tiny_stats.spills);
+    printf("life: %d mallocs predicted short-lived (%u bytes in their region), %d spilled; %d of %d sampled frees died young, %d flips\n",
+           life_stats.shorts, short_lo ? (unsigned int)((char *)mem_region_hi(short_region) + 1 - short_lo) : 0,
+           life_stats.spills, life_stats.young, life_stats.samples, life_stats.flips);
+    printf("quick: %d deferred frees (%d sized), %d hits, %d flushes\n",
+           quick_stats.deferred, quick_stats.sized, quick_stats.hits, quick_stats.flushes);
+    printf("realloc: %d shrink, %d next, %d extend, %d prev (in place) / %d copy\n",
+           realloc_stats.shrink, realloc_stats.next, realloc_stats.extend,
+           realloc_stats.prev, realloc_stats.copy);
+    printf("memalign: %d calls, %d leading fragments kept free\n",
+           align_stats.calls, align_stats.leads);
+    printf("fit: %s fit, %d searches, %.1f probes each, %d longest, %d wrapped, %d capped at %d, %u bytes grown after a cap\n",
+           fit_policy == FIT_NEXT ? "next" : "first",
+           fit_stats.searches, fit_stats.searches ? (double)fit_stats.probes / fit_stats.searches : 0.0,
+           fit_stats.longest, fit_stats.wraps, fit_stats.capped, FIT_PROBES, (unsigned int)fit_stats.grown);
+    printf("batch: %d carves for %d blocks, %d frees in %d runs\n",
+           batch_stats.carves, batch_stats.blocks, batch_stats.frees, batch_stats.runs);
+    printf("mmap: %d maps, %d remaps, %d unmaps (threshold %d)\n",
+           map_stats.maps, map_stats.remaps, map_stats.unmaps, MMAP_THRESHOLD);
+    printf("grow: %d extends, %u bytes (%d topped up the tail), step %u (max %d)\n",
+           grow_stats.extends, (unsigned int)grow_stats.bytes, grow_stats.tails,
+           (unsigned int)grow_step, GROW_MAX);
+    printf("place: %d low, %d high\n", place_stats.low, place_stats.high);
+    printf("hints: %d calls, %d with a lifetime, %d near (%d adjacent, %d same page), %d zeroed, %d already zero\n",
+           hint_stats.calls, hint_stats.lives, hint_stats.nears, hint_stats.adjacent, hint_stats.paged,
+           hint_stats.zeroed, hint_stats.fresh);
+    printf("trim: %d trims, %u bytes returned (threshold %d)\n",
+           trim_stats.trims, (unsigned int)trim_stats.bytes, TRIM_THRESHOLD);
 }
 
 /*
@@ -404,32 +1797,47 @@ void *mm_realloc(void *bp, size_t size)
 void mm_checkheap(int lineno)
 {
     char *heap_lo = mem_heap_lo();                      // pointing first word of the heap
-    char *heap_hi = heap_lo + (mem_heapsize()-WSIZE);   // pointing last word of the heap
+    char *heap_hi = (char *)mem_heap_hi() + 1 - WSIZE;  // pointing last word of the heap (mem_heapsize 는 mapping 도 센다)
     char *bp;
 
     /* heap level check*/
     //assert(GET(heap_lo) == 0);                          // check PROLOGUE next
     //assert(GET(heap_lo + 1*WSIZE) == 0);                // check PROLOGUE prev
-    assert(GET(heap_lo + 2*WSIZE) == PACK(WSIZE,1));    // check PROLOGUE footer
-    assert(GET(heap_hi) == PACK(0,1));                  // check epilogue block
+    assert(GET(heap_lo + (SKIP_LEVELS + 1)*WSIZE) == PACK(WSIZE,1));    // check PROLOGUE footer
+    assert(GET_SIZE(heap_hi) == 0 && GET_ALLOC(heap_hi));           // check epilogue block
 
-    /* block level */
-    for(bp = heap_listp ; GET_SIZE(HDRP(bp)) > 0 ; bp = NEXT_BLKP(bp)) {
-        assert(GET(HDRP(bp)) == GET(FTRP(bp)));     // check header and footer match
-        assert(!(UINT_CAST(bp) & 0x7));             // check if payload area aligned
+    /* block level : region 0, then the short-lived region */
+    // prologue footer (4/1) 의 크기는 GET_SIZE 로 읽으면 0 이므로, 첫 번째 블록부터 순회한다.
+    for (int r = 0; r < 2; r++) {
+    if (r == 1) {
+        if (short_lo == NULL)
+            break;
+        heap_lo = short_lo;                         // short_region 에는 prologue 가 없고 padding 뒤에 바로 블록이 온다.
+        heap_hi = (char *)mem_region_hi(short_region) + 1 - WSIZE;
+        assert(GET_SIZE(heap_hi) == 0 && GET_ALLOC(heap_hi));       // check epilogue block
+    }
+    size_t prev_alloc = PREV_ALLOC;                 // 첫 번째 블록의 앞은 prologue
+    for(bp = r ? short_lo + ALIGNMENT : heap_listp + WSIZE ; GET_SIZE(HDRP(bp)) > 0 ; bp = NEXT_BLKP(bp)) {
+        if (!GET_ALLOC(HDRP(bp)))
+            assert(GET(HDRP(bp)) == GET(FTRP(bp)));     // check header and footer match (free block only)
+        assert(GET_PREV_ALLOC(HDRP(bp)) == prev_alloc); // check PREV_ALLOC bit
+        assert(!(UINT_CAST(bp) & (ALIGNMENT-1)));   // check if payload area aligned
         assert(GET_ALLOC(HDRP(bp)) | GET_ALLOC(HDRP(NEXT_BLKP(bp))));   // check contiguous free blocks
-        assert(heap_lo < HDRP(bp) && FTRP(bp) < heap_hi);               // check heap bound
+        assert(heap_lo < HDRP(bp) && NEXT_BLKP(bp) - DSIZE < heap_hi);  // check heap bound
+        assert(r == IS_SHORT(bp));                  // check region
+        prev_alloc = GET_ALLOC(HDRP(bp)) ? PREV_ALLOC : 0;
 
         // check all free blocks are in the free list
         if (!GET_ALLOC(HDRP(bp))) {
             void *next_free;
-            for (next_free = (void *)GET(NEXT_FREE(root)); next_free != NULL; next_free = (void *)GET(NEXT_FREE(next_free))) {
+            for (next_free = GET_LINK(NEXT_FREE(root)); next_free != NULL; next_free = GET_LINK(NEXT_FREE(next_free))) {
                 if (next_free == bp)
                     break;
             }
             assert(next_free);
         }
     }
+    }
     // detect cycle
     char * hare; char *tortoise;
     hare = tortoise = root;
@@ -437,21 +1845,77 @@ void mm_checkheap(int lineno)
     while(1) {
         if (!hare || !GET(NEXT_FREE(hare)))
             break;
-        hare = (void *)GET(NEXT_FREE(GET(NEXT_FREE(hare))));
-        tortoise = (void *)GET(NEXT_FREE(tortoise));
+        hare = GET_LINK(NEXT_FREE(GET_LINK(NEXT_FREE(hare))));
+        tortoise = GET_LINK(NEXT_FREE(tortoise));
         printf("hare : %16p, tortoise: %16p\n", hare, tortoise);
         assert(hare != tortoise);
     }
     /* list level check */
     printf("<<free block list>>\n");
     void * free = root;
-    void * next_free = (void *)GET(NEXT_FREE(root));
+    void * next_free = GET_LINK(NEXT_FREE(root));
+    int rover_found = rover == NULL;
     while (next_free != NULL) {
         printf("free : %p, next free : %p\n", free, next_free);
         assert(!GET_ALLOC(HDRP(next_free)));
         assert(free < next_free);
+        rover_found |= next_free == rover;
 
         free = next_free;
-        next_free = (void *)GET(NEXT_FREE(next_free));
+        next_free = GET_LINK(NEXT_FREE(next_free));
+    }
+    assert(rover_found);                            // check rover is on the free list
+
+    /* skip list check : 각 층은 주소 순이고, 높이가 그 층보다 큰 가용 블록만 빠짐없이 담는다. */
+    for (int i = 1; i < SKIP_LEVELS; i++) {
+        int expected = 0, found = 0;
+        for (bp = GET_LINK(NEXT_FREE(root)); bp != NULL; bp = GET_LINK(NEXT_FREE(bp)))
+            expected += skip_height(bp, GET_SIZE(HDRP(bp))) > i;
+        free = root;
+        for (bp = GET_LINK(SKIP(root, i)); bp != NULL; bp = GET_LINK(SKIP(bp, i))) {
+            assert(!GET_ALLOC(HDRP(bp)) && skip_height(bp, GET_SIZE(HDRP(bp))) > i);
+            assert((char *)free < bp);
+            free = bp;
+            found++;
+            assert(found <= expected);              // also stops a cycle
+        }
+        assert(found == expected);
+    }
+
+    /* quick list check : deferred blocks still look allocated, so the checks above hold for them */
+    size_t deferred = 0;
+    for (int i = 0; i < NUM_QUICK; i++) {
+        for (bp = quick[i]; bp != NULL; bp = GET_LINK(NEXT_FREE(bp))) {
+            assert(GET_ALLOC(HDRP(bp)) && QUICK_INDEX(GET_SIZE(HDRP(bp))) == i);
+            deferred += QUICK_SIZE(i);
+            assert(deferred <= quick_bytes);        // also stops a cycle
+        }
     }
-}
\ No newline at end of file
+    assert(deferred == quick_bytes);
+
+    /* tiny page check */
+    if (tiny_lo != NULL) {
+        char *tiny_end = (char *)mem_region_hi(tiny_region) + 1;
+        int class, i, nfree, listed = 0, full = 0;
+        tiny_t *t;
+
+        assert(!(UINT_CAST(tiny_lo) & (TINY_PAGE - 1)));           // check tiny region is page aligned
+        for (t = (tiny_t *)tiny_lo; (char *)t < tiny_end; t = (tiny_t *)((char *)t + TINY_PAGE)) {
+            for (nfree = 0, i = 0; i < TINY_MAP_WORDS; i++)
+                nfree += __builtin_popcount(t->bitmap[i]);
+            assert(nfree == t->nfree && nfree <= t->nobjs);         // check bitmap matches the free count
+            assert(TINY_HDRSIZE + t->nobjs * t->objsize <= TINY_PAGE);
+            assert(!(t->objsize & (ALIGNMENT - 1)));                // check slots stay aligned
+            full += (t->nfree == 0);
+        }
+        for (class = 0; class < NUM_TINY_CLASSES; class++)
+            for (t = partial_tiny[class]; t != NULL; t = t->next, listed++) {
+                assert(t->class == class && t->objsize == tiny_size[class]);
+                assert(0 < t->nfree && t->nfree < t->nobjs);    // neither full nor empty
+                assert(t->next == NULL || t->next->prev == t);  // check back link
+            }
+        for (t = empty_tiny; t != NULL; t = t->next, listed++)
+            assert(t->nfree == t->nobjs);
+        assert(listed + full == (tiny_end - tiny_lo) / TINY_PAGE);  // every page is listed exactly once, or full
+    }
+}
@@ -2,8 +2,14 @@
  * mm-implicit.c - implicit free-list, immediate boundary-tag coalescing.
  * 
  * 경계 태그 연결(boundary-tag coalescing)을 사용하는 묵시적 가용 리스트 (implicit free-list)에 기초한 할당기.
- * 각 블록은 헤더(header)와 푸터(footer)를 가지며, 더블워드 정렬 기준이다.
- * 블록의 최소 크기(바이트) 는 16 bytes 이다.
+ * 각 블록은 헤더(header)를 가지며, 가용 블록만 푸터(footer)를 가진다. 더블워드 정렬 기준이다.
+ * 헤더의 PREV_ALLOC 비트에 앞 블록의 할당 여부를 기록하므로, 할당 블록에는 푸터가 필요 없다.
+ * 블록의 최소 크기(바이트) 는 8 bytes 이다. (가용 블록은 header + footer, 할당 블록은 header + 4 bytes payload)
+ *
+ * 힙 밖에 8 bytes 단위마다 한 비트씩 둔 비트맵 (free_map) 에, 가용 블록이 시작하는 자리를 표시한다.
+ * find_fit 은 블록을 하나씩 따라가지 않고 비트맵을 64 비트 워드 단위로 읽어서, 켜진 비트의 블록만 본다.
+ * 비트맵 워드마다 0 이 아닌지를 한 비트로 모은 요약 비트맵 (map_summary) 이 위에 있어서, 빈 워드들은 64 개씩 건너뛴다.
+ * 주소 순으로 보므로 first fit 결과는 같다. 힙 안의 경계 태그는 그대로이고, 비트맵은 전용 region 에 있어서 힙 크기에 같이 잡힌다.
  *
  * NOTE TO STUDENTS: Replace this header comment with your own header
  * comment that gives a high level description of your solution.
@@ -16,6 +22,7 @@
 
 #include "mm.h"
 #include "memlib.h"
+#include "config.h"
 
 /*********************************************************
  * NOTE TO STUDENTS: Before you do anything else, please
@@ -38,13 +45,29 @@ team_t team = {
 
 #define WSIZE       4       /* Word and header/footer size (bytes) */  
 #define DSIZE       8       /* Double word size (bytes) */  
+#define MINBLKSIZE  8       /* minimum block size with header and footer */
 #define CHUNKSIZE  (1<<12)  /* Extend heap by this amout (bytes) */
-#define ALIGNMENT   8       /* single word (4) or double word (8) alignment */
+#ifndef ALIGNMENT
+#define ALIGNMENT   8       /* double word (8) alignment */
+#endif
+#if ALIGNMENT != 8
+#error "mm-implicit.c supports only 8-byte alignment"
+#endif
 
 #define MAX(x, y) ((x) > (y)? (x) : (y))
 
-/* Pack a size and allocated bit into a word */
+/* Free block bitmap : one bit per DSIZE granule of the heap, set where a free block starts */
+#define MAP_REGION_SIZE (MAX_HEAP / DSIZE / 8)  /* most bitmap bytes, taken off the top of region 0; one bit per granule of MAX_HEAP */
+#define MAP_BITS        64              /* bits per bitmap word */
+#define MAP_BIT(bp)     ((size_t)((char *)(bp) - (char *)mem_heap_lo()) / DSIZE)
+#define MAP_MASK(bp)    (1ULL << (MAP_BIT(bp) % MAP_BITS))
+#define MAP_WORD(bp)    (MAP_BIT(bp) / MAP_BITS)
+#define GET_FREE_BIT(bp)    ((free_map[MAP_WORD(bp)] & MAP_MASK(bp)) != 0)
+#define SUMMARY_WORDS   (MAP_REGION_SIZE / 8 / MAP_BITS)   /* one summary bit per bitmap word */
+
+/* Pack a size and allocated bits into a word */
 #define PACK(size, alloc)   ((size) | (alloc))
+#define PREV_ALLOC  0x2     /* header bit : previous block is allocated */
 
 /* Read and write a word at address p */
 #define GET(p) (*((unsigned int *)(p)))
@@ -53,14 +76,20 @@ team_t team = {
 /* Read the size and allocated fields from address p. (p would be an address of header or footer of block)*/
 #define GET_SIZE(p) (GET(p) & ~0x7)
 #define GET_ALLOC(p) (GET(p) & 0x1)
+#define GET_PREV_ALLOC(p) (GET(p) & PREV_ALLOC)
 #define UINT_CAST(p) ((size_t)p)
 
+/* Set or clear the PREV_ALLOC bit of the header at address p */
+#define SET_PREV_ALLOC(p)   PUT(p, GET(p) | PREV_ALLOC)
+#define CLR_PREV_ALLOC(p)   PUT(p, GET(p) & ~PREV_ALLOC)
+
 /* bp(block pointer) : payload의 시작 주소를 가리키는 포인터이다. 헤더를 가리키지 않는다. */
 /* Given block ptr bp(), compute address of its header and footer */
 #define HDRP(bp)        ((char *)(bp) - WSIZE)
-#define FTRP(bp)        ((char *)(bp) + GET_SIZE(HDRP(bp)) - DSIZE)
+#define FTRP(bp)        ((char *)(bp) + GET_SIZE(HDRP(bp)) - DSIZE)     // 가용 블록에만 footer가 있다.
 
 /* Given block ptr bp, compute address of next and previous blocks */
+/* PREV_BLKP 는 앞 블록의 footer를 읽으므로, GET_PREV_ALLOC 으로 앞 블록이 가용임을 확인한 뒤에만 쓸 수 있다. */
 #define NEXT_BLKP(bp)   ((char *)(bp) + GET_SIZE(((char *)(bp) - WSIZE)))
 #define PREV_BLKP(bp)   ((char *)(bp) - GET_SIZE(((char *)(bp) - DSIZE)))
 
@@ -76,11 +105,20 @@ team_t team = {
 
 /* private variables */
 static char *heap_listp;
+static int map_region;
+static unsigned long long *free_map;    /* the bitmap, at the bottom of its own region */
+static size_t map_words;                /* bitmap words in use, enough for every granule of the heap */
+static unsigned long long map_summary[SUMMARY_WORDS];  /* bit i : free_map[i] != 0 */
 
 /* private function declarations */
 static void *extend_heap(size_t words);
+static int grow_map(size_t heapsize);
+static void set_free_bit(void *bp);
+static void clr_free_bit(void *bp);
 static void *find_fit(size_t asize);
 static void place(void *bp, size_t asize);
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset);
+static void place_aligned(void *bp, char *p, size_t asize);
 static void *coalesce(void *bp);
 
 /* 
@@ -95,10 +133,17 @@ int mm_init(void)
     PUT(heap_listp, 0);                                 /* Alignment padding*/
     PUT(heap_listp + (1*WSIZE), PACK(DSIZE, 1));        /* Prologue header */
     PUT(heap_listp + (2*WSIZE), PACK(DSIZE, 1));        /* Prologue footer */
-    PUT(heap_listp + (3*WSIZE), PACK(0, 1));            /* Epilogue header */
+    PUT(heap_listp + (3*WSIZE), PACK(0, PREV_ALLOC | 1));   /* Epilogue header */
     heap_listp += (2*WSIZE);
+
+    /* 비트맵 region 은 힙과 같이 비워진 상태에서 시작한다. */
+    if ((map_region = mem_region_new(MAP_REGION_SIZE)) < 0)
+        return -1;
+    free_map = mem_region_lo(map_region);
+    map_words = 0;
+    memset(map_summary, 0, sizeof(map_summary));
     /*                   unused   pro.hdr.   pro.ftr.   epl.hdr.
-     * start of heap : | unused |    8/1   |    8/1   |   0/1   |
+     * start of heap : | unused |    8/1   |    8/1   |  0/1/1  |
      *                                     |
      *                                 heap_listp           
      */
@@ -115,26 +160,65 @@ int mm_init(void)
  */
 static void *extend_heap(size_t words) // size_t a.k.a. {long, unsigned int} (stddef.h)
 {
-    char * origin = heap_listp - 8;
     char *bp;
     size_t size;
+    size_t prev_alloc;
 
     /* Allocate an even number of words to maintain alignment */
     size = (words % 2) ? (words+1) * WSIZE : words * WSIZE;     // 요청 크기를 2워드의 배수로 다시 맞춘다.
+    if (grow_map(mem_heap_hi() + 1 - mem_heap_lo() + size) < 0) // 늘어날 힙을 덮을 만큼 비트맵을 먼저 늘린다.
+        return NULL;
     if ((long)(bp = mem_sbrk(size)) == -1)
         return NULL;
-    size_t *hdr = HDRP(bp);
+    prev_alloc = GET_PREV_ALLOC(HDRP(bp));  // 이전 epilogue header 에 기록돼 있던 마지막 블록의 할당 여부
     /* Initialize free block header/footer and the epilogue header */
-    PUT(HDRP(bp), PACK(size, 0));           /* Free block header */     // 위에서 extend한 size가 encode 됨에 유의하자.
-    size_t *ftr = FTRP(bp);
-    PUT(FTRP(bp), PACK(size, 0));           /* Free block footer */
-    PUT(HDRP(NEXT_BLKP(bp)), PACK(0,1));    /* New epilogue header */
+    PUT(HDRP(bp), PACK(size, prev_alloc));  /* Free block header */     // 위에서 extend한 size가 encode 됨에 유의하자.
+    PUT(FTRP(bp), GET(HDRP(bp)));           /* Free block footer */
+    PUT(HDRP(NEXT_BLKP(bp)), PACK(0,1));    /* New epilogue header */   // 앞 블록(방금 만든 블록)은 가용이다.
 
 
     /* Coalesce if the previous block was free block */
     return coalesce(bp);
 }
 
+/*
+ * grow_map - heapsize 바이트 힙의 모든 8 bytes 단위를 덮도록 비트맵을 늘린다. 새 워드는 0 (할당) 으로 채운다.
+ */
+static int grow_map(size_t heapsize)
+{
+    size_t words = (heapsize / DSIZE + MAP_BITS - 1) / MAP_BITS;
+
+    if (words <= map_words)
+        return 0;
+    if (mem_region_sbrk(map_region, (words - map_words) * sizeof(*free_map)) == (void *)-1)
+        return -1;
+    memset(free_map + map_words, 0, (words - map_words) * sizeof(*free_map));
+    map_words = words;
+    return 0;
+}
+
+/*
+ * set_free_bit - bp 에서 가용 블록이 시작함을 표시한다.
+ */
+static void set_free_bit(void *bp)
+{
+    size_t w = MAP_WORD(bp);
+
+    free_map[w] |= MAP_MASK(bp);
+    map_summary[w / MAP_BITS] |= 1ULL << (w % MAP_BITS);
+}
+
+/*
+ * clr_free_bit - bp 의 표시를 지운다. 그 워드에 남은 비트가 없으면 요약 비트도 끈다.
+ */
+static void clr_free_bit(void *bp)
+{
+    size_t w = MAP_WORD(bp);
+
+    if ((free_map[w] &= ~MAP_MASK(bp)) == 0)
+        map_summary[w / MAP_BITS] &= ~(1ULL << (w % MAP_BITS));
+}
+
 /* 
  * mm_malloc - size 바이트의 메모리를 할당하고, 해당 블록의 포인터(bp)를 반환.
  *           - 적절한 크기의 free 블록을 찾지 못한 경우, extend_heap 을 통해 힙을 확장 후 할당.
@@ -151,10 +235,10 @@ void *mm_malloc(size_t size)
     }
 
     /* Adjust block size to include overhead and alignment reqs (double word). */
-    if (size <= DSIZE)
-        asize = 2*DSIZE;
+    if (size <= MINBLKSIZE - WSIZE)
+        asize = MINBLKSIZE;
     else
-        asize = ALIGN(size) + DSIZE;    // size는 사용자가 요구한 공간. 거기에 헤더와 푸터의 8바이트를 더해줘야 한다.
+        asize = ALIGN(size + WSIZE);    // size는 사용자가 요구한 공간. 할당 블록에는 footer가 없으므로 헤더 4바이트만 더해준다.
 
     /* Search the free list for a fit */
     if ((bp = find_fit(asize)) != NULL) {
@@ -174,14 +258,25 @@ void *mm_malloc(size_t size)
 
 /*
  * find_fit - find available free block for request.
+ *          - 요약 비트맵을 한 워드씩 읽어서 켜진 비트의 비트맵 워드만 보고, 그 워드에서 켜진 비트를 낮은 것부터 꺼 가며 블록의 크기를 본다.
+ *            요약 워드 하나가 0 이면 가용 블록이 시작하지 않는 32 KB 를 한 번에 건너뛴다.
 */
 static void *find_fit(size_t asize)
 {   // First-fit search
-    char *bp = heap_listp;
-    while (GET_SIZE(HDRP(bp = NEXT_BLKP(bp)))) { // 다음 블록이 epilogue 블록이 아니라면,
-        // 블록이 free이고, size가 asize보다 크다면 할당 가능하다.
-        if (!GET_ALLOC(HDRP(bp)) && (GET_SIZE(HDRP(bp)) >= asize))
-            return bp;
+    char *heap_lo = mem_heap_lo();
+    unsigned long long summary, word;
+    size_t s, w;
+    char *bp;
+
+    for (s = 0; s * MAP_BITS < map_words; s++) {
+        for (summary = map_summary[s]; summary != 0; summary &= summary - 1) {     // 가장 낮은 비트를 끈다.
+            w = s * MAP_BITS + __builtin_ctzll(summary);
+            for (word = free_map[w]; word != 0; word &= word - 1) {
+                bp = heap_lo + (w * MAP_BITS + __builtin_ctzll(word)) * DSIZE;
+                if (GET_SIZE(HDRP(bp)) >= asize)
+                    return bp;
+            }
+        }
     }
     return NULL;
 }
@@ -192,22 +287,20 @@ static void *find_fit(size_t asize)
 static void place(void *bp, size_t asize)
 {
     size_t original_size = GET_SIZE(HDRP(bp));  // 원래 블록의 사이즈
+    size_t prev_alloc = GET_PREV_ALLOC(HDRP(bp));
     size_t diff = original_size - asize;
     
-    if (diff >= DSIZE*2) {   // 원래 블록의 사이즈와 할당하려는 블록 사이즈의 차이가 블록의 최소크기 보다 커야 분할할 수 있다.
-        size_t *hdrp = HDRP(bp); size_t *ftrp = FTRP(bp);
-        PUT(HDRP(bp) , PACK(asize, 1));              // asize 만큼 할당.
-        ftrp = FTRP(bp);
-        PUT(FTRP(bp) , PACK(asize, 1));
+    clr_free_bit(bp);
+    if (diff >= MINBLKSIZE) {   // 원래 블록의 사이즈와 할당하려는 블록 사이즈의 차이가 블록의 최소크기 보다 커야 분할할 수 있다.
+        PUT(HDRP(bp) , PACK(asize, prev_alloc | 1));    // asize 만큼 할당. footer 없음.
         bp = NEXT_BLKP(bp);
-        hdrp = HDRP(bp);
-        PUT(HDRP(bp), PACK(diff, 0));     // 할당 후 남은 부분 diff 크기를 가진 free 블록으로 지정
-        ftrp = FTRP(bp);
-        PUT(FTRP(bp), PACK(diff, 0));     
+        PUT(HDRP(bp), PACK(diff, PREV_ALLOC));          // 할당 후 남은 부분 diff 크기를 가진 free 블록으로 지정
+        PUT(FTRP(bp), PACK(diff, PREV_ALLOC));     
+        set_free_bit(bp);
     }
     else {  // 분할 못하는 경우.
-        PUT(FTRP(bp), PACK(original_size, 1));
-        PUT(HDRP(bp), PACK(original_size, 1));           // 원래 블록을 전부 allocate 한다.
+        PUT(HDRP(bp), PACK(original_size, prev_alloc | 1));    // 원래 블록을 전부 allocate 한다.
+        SET_PREV_ALLOC(HDRP(NEXT_BLKP(bp)));                    // 뒤 블록에게 내가 할당됐음을 알린다.
     }
 }
 
@@ -217,42 +310,47 @@ static void place(void *bp, size_t asize)
 void mm_free(void *bp)
 {
     size_t size = GET_SIZE(HDRP(bp));
-    PUT(HDRP(bp), PACK(size, 0));       // size 그대로인 free 블록으로 지정.
-    PUT(FTRP(bp), PACK(size, 0));       // size 그대로인 free 블록으로 지정.
+    PUT(HDRP(bp), PACK(size, GET_PREV_ALLOC(HDRP(bp))));    // size 그대로인 free 블록으로 지정.
+    PUT(FTRP(bp), GET(HDRP(bp)));                           // 가용 블록이 되었으니 footer 도 써준다.
+    CLR_PREV_ALLOC(HDRP(NEXT_BLKP(bp)));                    // 뒤 블록에게 내가 가용이 되었음을 알린다.
     coalesce(bp);
 
 }
 
 static void *coalesce(void *bp)
 {
-    size_t prev_alloc = GET_ALLOC(FTRP(PREV_BLKP(bp)));     // 앞 블록의 할당 여부
+    size_t prev_alloc = GET_PREV_ALLOC(HDRP(bp));           // 앞 블록의 할당 여부 (앞 블록의 footer 대신 내 header 의 비트)
     size_t next_alloc = GET_ALLOC(HDRP(NEXT_BLKP(bp)));     // 뒤 블록의 할당 여부
     size_t size = GET_SIZE(HDRP(bp));                       // 현재 블록의 사이즈
 
     /* case 1 : 앞, 뒤 블록 모두 allocated 인 경우. */
     if (prev_alloc && next_alloc) {
+        set_free_bit(bp);
         return bp;
     }
     /* case 2 : 뒤 블록만 free 인 경우. */
     else if (prev_alloc && !next_alloc) {
+        clr_free_bit(NEXT_BLKP(bp));                        // 뒤 블록은 이제 내 안에 있다.
         size += GET_SIZE(HDRP(NEXT_BLKP(bp)));
-        PUT(HDRP(bp), PACK(size, 0));           // 현재 블록의 크기와 뒤 블록의 크기가 합쳐진 size가 현재 블록의 header에 인코딩됨.
-        PUT(FTRP(bp), PACK(size, 0));           // 위 라인 덕분에 FTRP(bp) 는 다음 블록의 footer를 가리키게 된다.
+        PUT(HDRP(bp), PACK(size, PREV_ALLOC));  // 현재 블록의 크기와 뒤 블록의 크기가 합쳐진 size가 현재 블록의 header에 인코딩됨.
+        PUT(FTRP(bp), PACK(size, PREV_ALLOC));  // 위 라인 덕분에 FTRP(bp) 는 다음 블록의 footer를 가리키게 된다.
     }
     /* case 3 : 앞 블록만 free 인 경우. */
     else if (!prev_alloc && next_alloc) {
         size += GET_SIZE(HDRP(PREV_BLKP(bp)));
-        PUT(FTRP(bp), PACK(size, 0));
-        PUT(HDRP(PREV_BLKP(bp)), PACK(size, 0));
+        PUT(FTRP(bp), PACK(size, PREV_ALLOC));          // 가용 블록의 앞 블록은 항상 할당 블록이다.
+        PUT(HDRP(PREV_BLKP(bp)), PACK(size, PREV_ALLOC));
         bp = PREV_BLKP(bp);
     }
     /* case 4 : 앞, 뒤 블록 모두 free 인 경우. */
     else {
+        clr_free_bit(NEXT_BLKP(bp));
         size += GET_SIZE(HDRP(PREV_BLKP(bp))) + GET_SIZE(FTRP(NEXT_BLKP(bp)));
-        PUT(HDRP(PREV_BLKP(bp)), PACK(size, 0));
-        PUT(FTRP(NEXT_BLKP(bp)), PACK(size, 0));
+        PUT(HDRP(PREV_BLKP(bp)), PACK(size, PREV_ALLOC));
+        PUT(FTRP(NEXT_BLKP(bp)), PACK(size, PREV_ALLOC));
         bp = PREV_BLKP(bp);
     }
+    set_free_bit(bp);                                       // case 3, 4 : 앞 블록의 비트는 이미 켜져 있다.
     return bp;
 }
 
@@ -268,7 +366,7 @@ void *mm_realloc(void *ptr, size_t size)
     newptr = mm_malloc(size);
     if (newptr == NULL)
       return NULL;
-    copySize = *(size_t *)((char *)oldptr - WSIZE);
+    copySize = GET_SIZE(HDRP(oldptr)) - WSIZE;    // 할당 블록의 payload 는 header 를 뺀 나머지 전부.
     if (size < copySize)
       copySize = size;
     memcpy(newptr, oldptr, copySize);
@@ -276,6 +374,162 @@ void *mm_realloc(void *ptr, size_t size)
     return newptr;
 }
 
+/*
+ * mm_memalign - payload 가 alignment 의 배수에 오는 블록을 준다. alignment 는 2의 거듭제곱이어야 한다.
+ */
+void *mm_memalign(size_t alignment, size_t size)
+{
+    return mm_memalign_offset(alignment, 0, size);
+}
+
+/*
+ * mm_memalign_offset - payload + offset 이 alignment 의 배수에 오는 블록을 준다. offset 은 ALIGNMENT 의 배수이다.
+ *                    - find_fit 처럼 비트맵을 주소 순으로 읽으면서 그 자리에 payload 가 들어가는 첫 가용 블록을 찾는다.
+ *                    - 앞 조각은 가용 블록으로 남긴다. 맞는 블록이 없으면 alignment 만큼 여유를 두고 힙을 늘린다.
+ */
+void *mm_memalign_offset(size_t alignment, size_t offset, size_t size)
+{
+    char *heap_lo = mem_heap_lo();
+    unsigned long long summary, word;
+    size_t asize, s, w;
+    char *bp, *p;
+
+    if (size == 0 || (alignment & (alignment - 1)) || offset % ALIGNMENT)
+        return NULL;
+    if (alignment <= ALIGNMENT)
+        return mm_malloc(size);
+
+    if (size <= MINBLKSIZE - WSIZE)
+        asize = MINBLKSIZE;
+    else
+        asize = ALIGN(size + WSIZE);
+
+    for (s = 0; s * MAP_BITS < map_words; s++) {
+        for (summary = map_summary[s]; summary != 0; summary &= summary - 1) {
+            w = s * MAP_BITS + __builtin_ctzll(summary);
+            for (word = free_map[w]; word != 0; word &= word - 1) {
+                bp = heap_lo + (w * MAP_BITS + __builtin_ctzll(word)) * DSIZE;
+                if ((p = aligned_spot(bp, asize, alignment, offset)) != NULL) {
+                    place_aligned(bp, p, asize);
+                    return p;
+                }
+            }
+        }
+    }
+
+    /* 앞 조각 (MINBLKSIZE 이상, alignment 미만) 이 생겨도 asize 가 들어가도록 늘린다. */
+    if ((bp = extend_heap(MAX(asize + alignment + MINBLKSIZE, CHUNKSIZE)/WSIZE)) == NULL)
+        return NULL;
+    p = aligned_spot(bp, asize, alignment, offset);
+    place_aligned(bp, p, asize);
+    return p;
+}
+
+/*
+ * aligned_spot - 가용 블록 bp 안에서 asize 블록의 payload + offset 이 alignment 경계에 오는 가장 앞 자리를 돌려준다. 없으면 NULL.
+ *              - 앞에 남는 조각은 없거나 (p == bp) MINBLKSIZE 이상이어야 가용 블록이 될 수 있다.
+ */
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset)
+{
+    char *p = (char *)((((size_t)bp + offset + alignment - 1) & ~(alignment - 1)) - offset);
+
+    if (p != (char *)bp && p - (char *)bp < MINBLKSIZE)
+        p += alignment;
+    return p + asize <= (char *)bp + GET_SIZE(HDRP(bp)) ? p : NULL;
+}
+
+/*
+ * place_aligned - 가용 블록 bp 의 p 자리에 asize 블록을 할당한다.
+ *               - 앞 조각은 bp 에서 시작하므로 비트맵의 비트는 그대로이다. p 부터는 가용 블록으로 만들어 place 에 맡긴다.
+ */
+static void place_aligned(void *bp, char *p, size_t asize)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    size_t lead = p - (char *)bp;
+
+    if (lead > 0) {
+        PUT(HDRP(bp), PACK(lead, PREV_ALLOC));      // 가용 블록의 앞 블록은 항상 할당 블록이다.
+        PUT(FTRP(bp), GET(HDRP(bp)));
+        PUT(HDRP(p), PACK(size - lead, 0));         // 앞 조각이 가용이므로 PREV_ALLOC 은 끈다.
+        PUT(FTRP(p), GET(HDRP(p)));
+        set_free_bit(p);
+    }
+    place(p, asize);
+}
+
+/*
+ * mm_free_sized - this engine does not use the size; same as mm_free.
+ */
+void mm_free_sized(void *ptr, size_t size)
+{
+    mm_free(ptr);
+}
+
+/*
+ * mm_usable_size - payload bytes of the block at ptr, at least the size it was requested with.
+ */
+size_t mm_usable_size(void *ptr)
+{
+    return GET_SIZE(HDRP(ptr)) - WSIZE;         // 할당 블록은 footer 가 없다.
+}
+
+/*
+ * mm_malloc_batch - this engine has no batch path; n calls to mm_malloc. Returns how many succeeded.
+ */
+size_t mm_malloc_batch(size_t size, size_t n, void **out)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if ((out[i] = mm_malloc(size)) == NULL)
+            break;
+    return i;
+}
+
+/*
+ * mm_free_batch - this engine has no batch path; n calls to mm_free.
+ */
+void mm_free_batch(void **ptrs, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        mm_free(ptrs[i]);
+}
+
+/*
+ * mm_set_place - this engine has one placement; the rule is ignored.
+ */
+void mm_set_place(size_t size, int end)
+{
+}
+
+/*
+ * mm_set_fit - this engine has one fit policy; the policy is ignored.
+ */
+void mm_set_fit(int policy)
+{
+}
+
+/*
+ * mm_malloc_flags - this engine takes no placement hints; mm_malloc, with the payload cleared for MALLOC_ZERO.
+ */
+void *mm_malloc_flags(size_t size, int flags, void *near)
+{
+    void *p = mm_malloc(size);
+
+    if (p != NULL && (flags & MALLOC_ZERO))
+        memset(p, 0, size);
+    return p;
+}
+
+/*
+ * mm_report - this engine keeps no counters.
+ */
+void mm_report(void)
+{
+}
+
 /*
  * mm_checkheap - check heap invariants for this implementation.
  *
@@ -286,25 +540,39 @@ void *mm_realloc(void *ptr, size_t size)
 void mm_checkheap(int lineno)
 {
     char *heap_lo = mem_heap_lo();                      // pointing first word of the heap
-    char *heap_hi = heap_lo + (mem_heapsize()-WSIZE);   // pointing last word of the heap
+    char *heap_hi = (char *)mem_heap_hi() + 1 - WSIZE;  // pointing last word of the heap (mem_heapsize 에는 비트맵도 들어간다)
     char *bp;
+    size_t free_blocks = 0, free_bits = 0, i;
 
     /* heap level check*/
     assert(GET(heap_lo) == 0);                          // check unused block
     assert(GET(heap_lo + 1*WSIZE) == PACK(DSIZE,1));    // check prologue block
     assert(GET(heap_lo + 2*WSIZE) == PACK(DSIZE,1));
-    assert(GET(heap_hi) == PACK(0,1));                  // check epilogue block
+    assert(GET_SIZE(heap_hi) == 0 && GET_ALLOC(heap_hi));   // check epilogue block
 
     /* block level, list level check */
-    for(bp = heap_listp ; GET_SIZE(HDRP(bp)) > 0 ; bp = NEXT_BLKP(bp)) {
+    size_t prev_alloc = PREV_ALLOC;                 // 첫 번째 블록의 앞은 prologue
+    for(bp = NEXT_BLKP(heap_listp) ; GET_SIZE(HDRP(bp)) > 0 ; bp = NEXT_BLKP(bp)) {
         // block level
-        char * ftr = FTRP(bp);
-        assert(GET(HDRP(bp)) == GET(FTRP(bp)));     // check header and footer match
+        if (!GET_ALLOC(HDRP(bp)))
+            assert(GET(HDRP(bp)) == GET(FTRP(bp)));     // check header and footer match (free block only)
+        assert(GET_PREV_ALLOC(HDRP(bp)) == prev_alloc); // check PREV_ALLOC bit
         assert(!(UINT_CAST(bp) & 0x7));             // check if payload area aligned
+        assert(GET_FREE_BIT(bp) == !GET_ALLOC(HDRP(bp)));   // check bitmap marks exactly the free blocks
+        free_blocks += !GET_ALLOC(HDRP(bp));
+        prev_alloc = GET_ALLOC(HDRP(bp)) ? PREV_ALLOC : 0;
 
         // list level
         assert(GET_ALLOC(HDRP(bp)) | GET_ALLOC(HDRP(NEXT_BLKP(bp))));   // check contiguous free blocks
                                                                         // alloc 여부가 (1,0), (0,1), (1,1) 이면 연속된 free블록이 없는 것이지만,
                                                                         // (0,0) 이면 연속된 free블록이 존재한다는 뜻.
     }
+
+    /* bitmap level check */
+    assert(map_words * MAP_BITS * DSIZE >= (size_t)(heap_hi + WSIZE - heap_lo));   // check bitmap covers the heap
+    for (i = 0; i < map_words; i++) {
+        free_bits += __builtin_popcountll(free_map[i]);
+        assert(((map_summary[i / MAP_BITS] >> (i % MAP_BITS)) & 1) == (free_map[i] != 0));    // check summary bit
+    }
+    assert(free_bits == free_blocks);               // check no bit left inside a block
 }
\ No newline at end of file
@@ -31,8 +31,13 @@ team_t team = {
     "dlrkddnr0421@daum.net"
 };
 
-/* single word (4) or double word (8) alignment */
+/* double word (8) alignment */
+#ifndef ALIGNMENT
 #define ALIGNMENT 8
+#endif
+#if ALIGNMENT != 8
+#error "mm-naive.c supports only 8-byte alignment"
+#endif
 
 /* rounds up to the nearest multiple of ALIGNMENT */
 #define ALIGN(size) (((size) + (ALIGNMENT-1)) & ~0x7)       // 7을 더해주고 하위 3개의 비트는 0으로 바꿔줌.
@@ -91,6 +96,99 @@ void *mm_realloc(void *ptr, size_t size)
     return newptr;
 }
 
+/*
+ * mm_memalign - this engine has no aligned placement. Alignments up to ALIGNMENT are plain mm_malloc;
+ *               larger ones fail with a message instead of padding the block by a whole alignment.
+ */
+void *mm_memalign(size_t alignment, size_t size)
+{
+    return mm_memalign_offset(alignment, 0, size);
+}
+
+/*
+ * mm_memalign_offset - same as mm_memalign, for payload + offset. Every payload is ALIGNMENT-aligned, so offset must be a multiple of it.
+ */
+void *mm_memalign_offset(size_t alignment, size_t offset, size_t size)
+{
+    if (alignment <= ALIGNMENT && offset % ALIGNMENT == 0)
+        return mm_malloc(size);
+    fprintf(stderr, "ERROR: mm_memalign(%u) failed. mm-naive.c has no aligned placement...\n", (unsigned int)alignment);
+    return NULL;
+}
+
+/*
+ * mm_free_sized - this engine does not use the size; same as mm_free.
+ */
+void mm_free_sized(void *ptr, size_t size)
+{
+    mm_free(ptr);
+}
+
+/*
+ * mm_usable_size - payload bytes of the block at ptr, at least the size it was requested with.
+ */
+size_t mm_usable_size(void *ptr)
+{
+    return *(size_t *)((char *)ptr - SIZE_T_SIZE);
+}
+
+/*
+ * mm_malloc_batch - this engine has no batch path; n calls to mm_malloc. Returns how many succeeded.
+ */
+size_t mm_malloc_batch(size_t size, size_t n, void **out)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if ((out[i] = mm_malloc(size)) == NULL)
+            break;
+    return i;
+}
+
+/*
+ * mm_free_batch - this engine has no batch path; n calls to mm_free.
+ */
+void mm_free_batch(void **ptrs, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        mm_free(ptrs[i]);
+}
+
+/*
+ * mm_set_place - this engine has one placement; the rule is ignored.
+ */
+void mm_set_place(size_t size, int end)
+{
+}
+
+/*
+ * mm_set_fit - this engine has one fit policy; the policy is ignored.
+ */
+void mm_set_fit(int policy)
+{
+}
+
+/*
+ * mm_malloc_flags - this engine takes no placement hints; mm_malloc, with the payload cleared for MALLOC_ZERO.
+ */
+void *mm_malloc_flags(size_t size, int flags, void *near)
+{
+    void *p = mm_malloc(size);
+
+    if (p != NULL && (flags & MALLOC_ZERO))
+        memset(p, 0, size);
+    return p;
+}
+
+/*
+ * mm_report - this engine keeps no counters.
+ */
+void mm_report(void)
+{
+}
+
 
 
 
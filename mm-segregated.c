@@ -0,0 +1,604 @@
+/*
+ * mm-segregated.c - segregated free-lists (size classes), LIFO within a class, immediate boundary-tag coalescing.
+ *
+ * mm-explicit.c 의 명시적 가용 리스트를 크기 클래스(size class)별로 나눈 분리 가용 리스트 (segregated free-list) 할당기.
+ * 모든 블록은 header와 footer을 가지며, 가용 블록은 추가로 prev free block pointer와 next free block pointer를 가진다.
+ * 각 크기 클래스의 리스트 헤드는 prologue 영역에 배열로 놓이고, 클래스 안에서는 새로 free 된 블록을 맨 앞에 넣는다 (LIFO).
+ * find_fit 은 요청 크기의 클래스부터 시작해서 더 큰 클래스로 올라가며 first-fit 으로 탐색한다.
+ * 더블워드 정렬 기준이다. 블록의 최소 크기(바이트) 는 16 bytes 이다.
+ *
+ * NOTE TO STUDENTS: Replace this header comment with your own header
+ * comment that gives a high level description of your solution.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "mm.h"
+#include "memlib.h"
+
+/*********************************************************
+ * NOTE TO STUDENTS: Before you do anything else, please
+ * provide your team information in the following struct.
+ ********************************************************/
+team_t team = {
+    /* Team name */
+    "JUNGLE_W06_TEAM_7",
+    /* First member's full name */
+    "LEE_KANG_WOOK",
+    /* First member's email address */
+    "dlrkddnr0421@daum.net",
+    /* Second member’s full name (leave blank if none) */
+    "",
+    /* Second member’s email address (leave blank if none) */
+    ""
+};
+
+/* Basic constants and macros*/
+
+#define WSIZE       4       /* Word and header/footer size (bytes) */
+#define DSIZE       8       /* Double word size (bytes) */
+#define MINBLKSIZE  16      /* minimum block size with header and footer */
+#define CHUNKSIZE  (1<<12)  /* Extend heap by this amout (bytes) */
+#ifndef ALIGNMENT
+#define ALIGNMENT   8       /* double word (8) alignment */
+#endif
+#if ALIGNMENT != 8
+#error "mm-segregated.c supports only 8-byte alignment"
+#endif
+#define NUM_CLASSES 12      /* number of size classes (must be even to keep alignment) */
+
+#define MAX(x, y) ((x) > (y)? (x) : (y))
+
+/* Pack a size and allocated bit into a word */
+#define PACK(size, alloc)   ((size) | (alloc))
+
+/* Read and write a word at address p */
+#define GET(p) (*((unsigned int *)(p)))
+#define PUT(p, val) (*(unsigned int *)(p) = (val))
+
+/* Read the size and allocated fields from address p. (p would be an address of header or footer of block)*/
+#define GET_SIZE(p) (GET(p) & ~0x7)
+#define GET_ALLOC(p) (GET(p) & 0x1)
+#define UINT_CAST(p) ((size_t)p)
+
+/* bp(block pointer) : payload의 시작 주소를 가리키는 포인터이다. 헤더를 가리키지 않는다. */
+/* Given block ptr bp(), compute address of its header and footer */
+#define HDRP(bp)        ((char *)(bp) - WSIZE)
+#define FTRP(bp)        ((char *)(bp) + GET_SIZE(HDRP(bp)) - DSIZE)
+
+/* Given block ptr bp, compute address of next and previous blocks */
+#define NEXT_BLKP(bp)   ((char *)(bp) + GET_SIZE(((char *)(bp) - WSIZE)))
+#define PREV_BLKP(bp)   ((char *)(bp) - GET_SIZE(((char *)(bp) - DSIZE)))
+
+/* Given free block ptr bp, compute address of previous and next free blocks */
+#define NEXT_FREE(bp)   ((void *)((char *)bp))
+#define PREV_FREE(bp)   ((void *)((char *)bp + WSIZE))
+
+/* Read and write a free-list link at address p : 32-bit offset from link_base, 0 is NULL */
+#define GET_LINK(p)         ((void *)(GET(p) ? link_base + GET(p) : NULL))
+#define PUT_LINK(p, ptr)    PUT(p, (ptr) ? (unsigned int)((char *)(ptr) - link_base) : 0)
+
+/* Given size class index, compute address of its list head in the prologue area */
+// 리스트 헤드는 NEXT_FREE 워드 하나만 가지는 더미 블록이다. (update_pointer 가 prev 의 NEXT_FREE 만 건드리므로 충분)
+#define CLASS_ROOT(i)   ((void *)(seg_listp + (i)*WSIZE))
+
+/* rounds up to the nearest multiple of ALIGNMENT */
+#define ALIGN(size) (((size) + (ALIGNMENT-1)) & ~0x7)       // 7을 더해주고 하위 3개의 비트는 0으로 바꿔줌.
+                                                            // 그러면 나보다 높으면서 가장 가까운 8의 배수가 될 수 있다.
+
+/* heap checker */
+#ifdef DEBUG
+# define CHECKHEAP() printf("\n%s : %d\n", __func__,__LINE__); mm_checkheap(__LINE__);
+#endif
+
+/* private variables */
+static char *heap_listp;
+static char *seg_listp;     /* points to the list head of size class 0 */
+static char *link_base;                     /* free-list links are offsets from here */
+
+/* private function declarations */
+int mm_init(void);
+static void *extend_heap(size_t words);
+static int size_class(size_t size);
+static void *find_fit(size_t asize);
+static void place(void *bp, size_t asize);
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset);
+static void place_aligned(void *bp, char *p, size_t asize);
+static void *coalesce(void *bp);
+static void update_pointer(void *bp, void *prev, void *next);
+static void *insert_free(void *bp);
+static void remove_free(void *bp);
+static void mm_checkheap(int lineno);
+
+/*
+ * mm_init - Initializes the heap like that shown below.
+ -------------------------------------------------------------------------------------------------------------
+ * <initialized heap image>
+ * @                          @                                         @                           @  - double word alignment
+ *  _____________ ____________               _____________ _____________ _____________
+ * |   CLASS 0   |   CLASS 1  |             | CLASS N-1   |   PROLOGUE  |             |
+ * |     root    |    root    |     ...     |    root     |    footer   |   EPILOGUE  |
+ * |-------------|------------|             |-------------|-------------|-------------|
+ * |      0      |      0     |             |      0      |    4 / 1    |    0 / 1    |
+ * |-------------|------------|             |-------------|-------------|-------------|
+ * ^                                                                    ^
+ * seg_listp                                                        heap_listp
+ -------------------------------------------------------------------------------------------------------------
+ * 클래스 i 의 헤드는 NEXT_FREE 만 가진 더미 블록이다. 클래스 i 에는 크기가 (MINBLKSIZE << (i-1), MINBLKSIZE << i]
+ * 범위인 가용 블록들이 LIFO 순으로 연결된다. 마지막 클래스는 그보다 큰 모든 블록을 받는다.
+ */
+int mm_init(void)
+{
+    int i;
+
+    link_base = (char *)mem_heap_lo() - WSIZE;  // 힙 맨 앞 블록도 0 이 아닌 offset 을 갖도록 한 워드 앞에 둔다.
+    /* Create the initial empty heap */
+    if ((seg_listp = mem_sbrk((NUM_CLASSES + 2)*WSIZE)) == (void *)-1)     // 시스템에 요청한 heap공간 할당이 실패했을 때.
+        return -1;
+    for (i = 0; i < NUM_CLASSES; i++)
+        PUT(CLASS_ROOT(i), 0);                                  /* CLASS i root */
+    PUT(seg_listp + (NUM_CLASSES+0)*WSIZE, PACK(4, 1));        /* PROLOGUE footer */
+    PUT(seg_listp + (NUM_CLASSES+1)*WSIZE, PACK(0, 1));        /* EPILOGUE */
+    heap_listp = seg_listp + (NUM_CLASSES+1)*WSIZE;
+
+    /* Extend the empty heap with a free block of CHUNKSIZE bytes */
+    if (extend_heap(CHUNKSIZE/WSIZE) == NULL)   // 필요한 워드의 개수를 인자로 넘긴다.
+        return -1;
+
+    return 0;
+}
+
+/*
+ * extend_heap은
+ * 1. 힙이 초기화 될 때, 또는
+ * 2.mm_malloc이 적당한 맞춤 fit을 찾지 못했을 때 호출된다.
+ */
+static void *extend_heap(size_t words)
+{
+    char *bp;
+    size_t size;
+
+    /* Allocate an even number of words to maintain alignment */
+    size = (words % 2) ? (words+1) * WSIZE : words * WSIZE;     // 요청 크기를 2워드의 배수로 다시 맞춘다.
+    if ((long)(bp = mem_sbrk(size)) == -1)
+        return NULL;
+    /* Initialize free block header/footer and the epilogue header */
+    PUT(HDRP(bp), PACK(size, 0));           /* Free block header */
+    PUT(FTRP(bp), PACK(size, 0));           /* Free block footer */
+    PUT(HDRP(NEXT_BLKP(bp)), PACK(0,1));    /* New epilogue header */
+
+    /* Coalesce if the previous block was free block */
+    return coalesce(bp);
+}
+
+/*
+ * size_class - map a block size to the index of its size class.
+ */
+static int size_class(size_t size)
+{
+    int i = 0;
+    size_t limit = MINBLKSIZE;
+
+    while (i < NUM_CLASSES - 1 && size > limit) {   // 클래스 i 의 상한은 MINBLKSIZE << i
+        limit <<= 1;
+        i++;
+    }
+    return i;
+}
+
+/*
+ * mm_malloc - size 바이트의 메모리를 할당하고, 해당 블록의 포인터(bp)를 반환.
+ *           - 적절한 크기의 free 블록을 찾지 못한 경우, extend_heap 을 통해 힙을 확장 후 할당.
+ */
+void *mm_malloc(size_t size)
+{
+    size_t asize;       /* Adjusted block size for alignment */
+    size_t extendsize;  /* Amount to extend heap if no fit */
+    char *bp;
+
+    /* 불필요한 요청 무시 */
+    if (size == 0) {
+        return NULL;
+    }
+
+    /* Adjust block size to include overhead and alignment reqs (double word). */
+    if (size <= MINBLKSIZE - DSIZE)
+        asize = MINBLKSIZE;
+    else
+        asize = ALIGN(size) + DSIZE;
+
+    /* Search the free lists for a fit */
+    if ((bp = find_fit(asize)) != NULL) {
+        place(bp, asize);
+
+        return bp;
+    }
+
+    /* No fit found. Get more memory and place the block */
+    extendsize = MAX(asize, CHUNKSIZE);
+    if ((bp = extend_heap(extendsize/WSIZE)) == NULL)
+        return NULL;
+
+    place(bp, asize);
+
+    return bp;
+}
+
+/*
+ * find_fit - find available free block for request.
+ *          - asize 가 속한 클래스부터 first-fit 으로 찾고, 없으면 다음 클래스로 넘어간다.
+*/
+static void *find_fit(size_t asize)
+{
+    int i;
+
+    for (i = size_class(asize); i < NUM_CLASSES; i++) {
+        for (void *bp = GET_LINK(NEXT_FREE(CLASS_ROOT(i))); bp != NULL; bp = GET_LINK(NEXT_FREE(bp))) {
+            if (GET_SIZE(HDRP(bp)) >= asize)
+                return bp;
+        }
+    }
+    return NULL;
+}
+
+/*
+ * update_pointer - update pointers of bp, prev, next
+*/
+static void update_pointer(void *bp, void *prev, void *next) {
+    // 내 꺼
+    PUT_LINK(PREV_FREE(bp), prev);
+    PUT_LINK(NEXT_FREE(bp), next);
+    // 남의 꺼
+    PUT_LINK(NEXT_FREE(prev), bp);
+    if (next)
+        PUT_LINK(PREV_FREE(next), bp);
+}
+
+/*
+ * place - place allocated block and divide if possible.
+ *       - 블록을 리스트에서 빼고, 남는 부분은 그 크기에 맞는 클래스에 다시 넣는다.
+ */
+static void place(void *bp, size_t asize)
+{
+    size_t original_size = GET_SIZE(HDRP(bp));  // 원래 블록의 사이즈
+    size_t diff = original_size - asize;
+
+    remove_free(bp);
+
+    if (diff >= MINBLKSIZE) {   // 원래 블록의 사이즈와 할당하려는 블록 사이즈의 차이가 블록의 최소크기 보다 커야 분할할 수 있다.
+
+        // 할당 처리
+        PUT(HDRP(bp) , PACK(asize, 1));             // header (asize / 1)
+        PUT(FTRP(bp) , PACK(asize, 1));             // footer (asize / 1)
+        void * leftover_bp = NEXT_BLKP(bp);
+
+        // 남은 부분 가용 처리
+        PUT(HDRP(leftover_bp), PACK(diff, 0));      // header (diff / 0)
+        PUT(FTRP(leftover_bp), PACK(diff, 0));      // footer (diff / 0)
+
+        insert_free(leftover_bp);
+    }
+    else {  // 분할 못하는 경우.
+
+        // 원래 블록을 전부 할당 처리.
+        PUT(FTRP(bp), PACK(original_size, 1));
+        PUT(HDRP(bp), PACK(original_size, 1));
+    }
+}
+
+/*
+ * mm_free - 일단 현재 블록을 free해주고, coalese 를 통해 경우에 따라 인접한 블록들을 연결을 해준다.
+ */
+void mm_free(void *bp)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    PUT(HDRP(bp), PACK(size, 0));       // size 그대로인 free 블록으로 지정.
+    PUT(FTRP(bp), PACK(size, 0));       // size 그대로인 free 블록으로 지정.
+    coalesce(bp);
+}
+
+/*
+ * insert_free - free된 블럭을 크기에 맞는 클래스의 리스트 맨 앞에 넣는다. (LIFO, O(1))
+*/
+static void *insert_free(void *bp) {
+    void * root = CLASS_ROOT(size_class(GET_SIZE(HDRP(bp))));
+
+    update_pointer(bp, root, GET_LINK(NEXT_FREE(root)));
+    return bp;
+}
+
+/*
+ * remove_free - 가용 블록 bp 를 자신이 속한 클래스의 리스트에서 뺀다.
+ *             - 어떠한 포인터도 bp 를 가리키지 않게되면 리스트에서 삭제된 것이다.
+*/
+static void remove_free(void *bp) {
+    PUT(NEXT_FREE(GET_LINK(PREV_FREE(bp))), GET(NEXT_FREE(bp)));
+    if (GET(NEXT_FREE(bp)))
+        PUT(PREV_FREE(GET_LINK(NEXT_FREE(bp))), GET(PREV_FREE(bp)));
+}
+
+/*
+ * coalesce - 인접한 가용 블록과 합친다.
+ *          - 합쳐진 블록은 크기가 바뀌어 클래스가 달라질 수 있으므로, 이웃 블록을 리스트에서 빼고 결과 블록을 다시 넣는다.
+ */
+static void *coalesce(void *bp)
+{
+    size_t prev_alloc = GET_ALLOC(bp - DSIZE);              // 앞 블록의 할당 여부  // prologue에는 header가 없어서 이런 방식으로 계산.
+    size_t next_alloc = GET_ALLOC(HDRP(NEXT_BLKP(bp)));     // 뒤 블록의 할당 여부
+    size_t size = GET_SIZE(HDRP(bp));                       // 현재 블록의 사이즈
+
+    /* case 1 : 앞, 뒤 블록 모두 allocated 인 경우. */
+    if (prev_alloc && next_alloc) {
+    }
+    /* case 3 : 앞 블록만 free 인 경우. */
+    else if (next_alloc) {
+        remove_free(PREV_BLKP(bp));
+        size += GET_SIZE(HDRP(PREV_BLKP(bp)));
+        PUT(FTRP(bp), PACK(size, 0));
+        PUT(HDRP(PREV_BLKP(bp)), PACK(size, 0));
+        bp = PREV_BLKP(bp);
+    }
+    /* case 2 : 뒤 블록만 free 인 경우. */
+    else if (prev_alloc) {
+        remove_free(NEXT_BLKP(bp));
+        size += GET_SIZE(HDRP(NEXT_BLKP(bp)));
+        PUT(HDRP(bp), PACK(size, 0));           // 현재 블록의 크기와 뒤 블록의 크기가 합쳐진 size가 현재 블록의 header에 인코딩됨.
+        PUT(FTRP(bp), PACK(size, 0));           // 위 라인 덕분에 FTRP(bp) 는 다음 블록의 footer를 가리키게 된다.
+    }
+    /* case 4 : 앞, 뒤 블록 모두 free 인 경우. */
+    else {
+        remove_free(PREV_BLKP(bp));
+        remove_free(NEXT_BLKP(bp));
+        size += GET_SIZE(HDRP(PREV_BLKP(bp))) + GET_SIZE(FTRP(NEXT_BLKP(bp)));
+        PUT(HDRP(PREV_BLKP(bp)), PACK(size, 0));
+        PUT(FTRP(NEXT_BLKP(bp)), PACK(size, 0));
+        bp = PREV_BLKP(bp);
+    }
+    return insert_free(bp);
+}
+
+/*
+ * mm_realloc - Implemented simply in terms of mm_malloc and mm_free
+ */
+void *mm_realloc(void *bp, size_t size)
+{
+    void *oldptr = bp;
+    void *newptr;
+    size_t copySize;
+
+    newptr = mm_malloc(size);
+    if (newptr == NULL)
+      return NULL;
+    copySize = GET_SIZE(HDRP(oldptr)) - DSIZE;
+    if (size < copySize)
+      copySize = size;
+    memcpy(newptr, oldptr, copySize);
+
+    mm_free(oldptr);
+    return newptr;
+}
+
+/*
+ * mm_memalign - payload 가 alignment 의 배수에 오는 블록을 준다. alignment 는 2의 거듭제곱이어야 한다.
+ */
+void *mm_memalign(size_t alignment, size_t size)
+{
+    return mm_memalign_offset(alignment, 0, size);
+}
+
+/*
+ * mm_memalign_offset - payload + offset 이 alignment 의 배수에 오는 블록을 준다. offset 은 ALIGNMENT 의 배수이다.
+ *                    - 요청 크기의 클래스부터 올라가며 그 자리에 payload 가 들어가는 가용 블록을 찾는다.
+ *                    - 앞에 남는 조각은 가용 블록으로 떼어서 자기 클래스에 넣는다. 맞는 블록이 없으면 alignment 만큼 여유를 두고 힙을 늘린다.
+ */
+void *mm_memalign_offset(size_t alignment, size_t offset, size_t size)
+{
+    size_t asize;
+    char *p = NULL;
+    void *bp = NULL;
+    int i;
+
+    if (size == 0 || (alignment & (alignment - 1)) || offset % ALIGNMENT)
+        return NULL;
+    if (alignment <= ALIGNMENT)
+        return mm_malloc(size);
+
+    if (size <= MINBLKSIZE - DSIZE)
+        asize = MINBLKSIZE;
+    else
+        asize = ALIGN(size) + DSIZE;
+
+    for (i = size_class(asize); i < NUM_CLASSES && p == NULL; i++)
+        for (bp = GET_LINK(NEXT_FREE(CLASS_ROOT(i))); bp != NULL; bp = GET_LINK(NEXT_FREE(bp)))
+            if ((p = aligned_spot(bp, asize, alignment, offset)) != NULL)
+                break;
+
+    if (p == NULL) {        // 앞 조각 (MINBLKSIZE 이상, alignment 미만) 이 생겨도 asize 가 들어가도록 늘린다.
+        if ((bp = extend_heap(MAX(asize + alignment + MINBLKSIZE, CHUNKSIZE)/WSIZE)) == NULL)
+            return NULL;
+        p = aligned_spot(bp, asize, alignment, offset);
+    }
+
+    place_aligned(bp, p, asize);
+    return p;
+}
+
+/*
+ * aligned_spot - 가용 블록 bp 안에서 asize 블록의 payload + offset 이 alignment 경계에 오는 가장 앞 자리를 돌려준다. 없으면 NULL.
+ *              - 앞에 남는 조각은 없거나 (p == bp) MINBLKSIZE 이상이어야 가용 블록이 될 수 있다.
+ */
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset)
+{
+    char *p = (char *)((((size_t)bp + offset + alignment - 1) & ~(alignment - 1)) - offset);
+
+    if (p != (char *)bp && p - (char *)bp < MINBLKSIZE)
+        p += alignment;
+    return p + asize <= (char *)bp + GET_SIZE(HDRP(bp)) ? p : NULL;
+}
+
+/*
+ * place_aligned - 가용 블록 bp 의 p 자리에 asize 블록을 할당한다.
+ *               - 앞 조각은 크기가 줄어서 클래스가 바뀔 수 있으므로 빼고 다시 넣는다. p 부터는 가용 블록으로 만들어 place 에 맡긴다.
+ */
+static void place_aligned(void *bp, char *p, size_t asize)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    size_t lead = p - (char *)bp;
+
+    if (lead > 0) {
+        remove_free(bp);
+        PUT(HDRP(bp), PACK(lead, 0));
+        PUT(FTRP(bp), PACK(lead, 0));
+        insert_free(bp);
+        PUT(HDRP(p), PACK(size - lead, 0));
+        PUT(FTRP(p), PACK(size - lead, 0));
+        insert_free(p);
+    }
+    place(p, asize);
+}
+
+/*
+ * mm_free_sized - same as mm_free. The class cannot come from the size: a block that was not split is larger
+ *                 than the adjusted request, the footer to write sits at its real end, and coalescing changes the class anyway.
+ */
+void mm_free_sized(void *ptr, size_t size)
+{
+    mm_free(ptr);
+}
+
+/*
+ * mm_usable_size - payload bytes of the block at ptr, at least the size it was requested with.
+ */
+size_t mm_usable_size(void *ptr)
+{
+    return GET_SIZE(HDRP(ptr)) - DSIZE;
+}
+
+/*
+ * mm_malloc_batch - this engine has no batch path; n calls to mm_malloc. Returns how many succeeded.
+ */
+size_t mm_malloc_batch(size_t size, size_t n, void **out)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if ((out[i] = mm_malloc(size)) == NULL)
+            break;
+    return i;
+}
+
+/*
+ * mm_free_batch - this engine has no batch path; n calls to mm_free.
+ */
+void mm_free_batch(void **ptrs, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        mm_free(ptrs[i]);
+}
+
+/*
+ * mm_set_place - this engine has one placement; the rule is ignored.
+ */
+void mm_set_place(size_t size, int end)
+{
+}
+
+/*
+ * mm_set_fit - this engine has one fit policy; the policy is ignored.
+ */
+void mm_set_fit(int policy)
+{
+}
+
+/*
+ * mm_malloc_flags - this engine takes no placement hints; mm_malloc, with the payload cleared for MALLOC_ZERO.
+ */
+void *mm_malloc_flags(size_t size, int flags, void *near)
+{
+    void *p = mm_malloc(size);
+
+    if (p != NULL && (flags & MALLOC_ZERO))
+        memset(p, 0, size);
+    return p;
+}
+
+/*
+ * mm_report - this engine keeps no counters.
+ */
+void mm_report(void)
+{
+}
+
+/*
+ * mm_checkheap - check heap invariants for this implementation.
+ *
+ * #ifdef DEBUG
+ *   CHECKHEAP();
+ * #endif
+*/
+void mm_checkheap(int lineno)
+{
+    char *heap_lo = mem_heap_lo();                      // pointing first word of the heap
+    char *heap_hi = heap_lo + (mem_heapsize()-WSIZE);   // pointing last word of the heap
+    char *bp;
+    int i;
+    int heap_free_cnt = 0;
+    int list_free_cnt = 0;
+
+    /* heap level check*/
+    assert(GET(heap_lo + NUM_CLASSES*WSIZE) == PACK(WSIZE,1));     // check PROLOGUE footer
+    assert(GET(heap_hi) == PACK(0,1));                              // check epilogue block
+
+    /* block level */
+    // prologue footer (4/1) 의 크기는 GET_SIZE 로 읽으면 0 이므로, 첫 번째 블록부터 순회한다.
+    for(bp = heap_listp + WSIZE ; GET_SIZE(HDRP(bp)) > 0 ; bp = NEXT_BLKP(bp)) {
+        assert(GET(HDRP(bp)) == GET(FTRP(bp)));     // check header and footer match
+        assert(!(UINT_CAST(bp) & 0x7));             // check if payload area aligned
+        assert(GET_ALLOC(HDRP(bp)) | GET_ALLOC(HDRP(NEXT_BLKP(bp))));   // check contiguous free blocks
+        assert(heap_lo < HDRP(bp) && FTRP(bp) < heap_hi);               // check heap bound
+
+        // check all free blocks are in the free list of their own class
+        if (!GET_ALLOC(HDRP(bp))) {
+            void *next_free;
+            for (next_free = GET_LINK(NEXT_FREE(CLASS_ROOT(size_class(GET_SIZE(HDRP(bp))))));
+                 next_free != NULL; next_free = GET_LINK(NEXT_FREE(next_free))) {
+                if (next_free == bp)
+                    break;
+            }
+            assert(next_free);
+            heap_free_cnt++;
+        }
+    }
+
+    /* list level check */
+    for (i = 0; i < NUM_CLASSES; i++) {
+        // detect cycle
+        char * hare; char *tortoise;
+        hare = tortoise = CLASS_ROOT(i);
+        while(1) {
+            if (!hare || !GET(NEXT_FREE(hare)))
+                break;
+            hare = GET_LINK(NEXT_FREE(GET_LINK(NEXT_FREE(hare))));
+            tortoise = GET_LINK(NEXT_FREE(tortoise));
+            assert(hare != tortoise);
+        }
+
+        void * free = CLASS_ROOT(i);
+        void * next_free = GET_LINK(NEXT_FREE(free));
+        while (next_free != NULL) {
+            assert(!GET_ALLOC(HDRP(next_free)));
+            assert(size_class(GET_SIZE(HDRP(next_free))) == i);    // check block is in the right class
+            assert(GET_LINK(PREV_FREE(next_free)) == free);      // check back link
+            list_free_cnt++;
+
+            free = next_free;
+            next_free = GET_LINK(NEXT_FREE(next_free));
+        }
+    }
+    assert(heap_free_cnt == list_free_cnt);     // no stale block left in any list
+}
@@ -0,0 +1,888 @@
+/*
+ * mm-slab.c - slab sub-allocator for small objects over an explicit free-list (mm-explicit.c).
+ *
+ * SLAB_MAXSIZE (128) 바이트 이하의 요청은 slab 에서, 더 큰 요청은 mm-explicit.c 와 같은 명시적 가용 리스트에서 할당한다.
+ *  - slab 은 SLAB_PAGE (4096) 바이트 페이지 하나로, 한 크기 클래스(8, 16, ... 128 bytes)의 slot 들로 나뉜다.
+ *  - 페이지 맨 앞에 slab_t 가 있고, slot 마다 bitmap 의 비트 하나로 가용 여부를 기록한다. slot 에는 header 도 footer 도 없다.
+ *  - slab 페이지들은 mm_init 이 mem_region_new 로 받은 전용 region 에서 mem_region_sbrk 로 한 페이지씩 떼어 온다.
+ *    region 은 페이지 경계에서 시작하므로, 블록 주소의 하위 비트를 지우면 그 블록의 slab_t 가 나온다.
+ *  - mm_free 는 주소가 slab region 안에 있는지만 보고 slab 으로 보낼지 명시적 리스트로 보낼지 정한다.
+ *  - 클래스마다 빈 slot 이 있는 slab 들의 이중 연결 리스트(partial) 를 두고, 다 빈 slab 은 empty_slabs 로 옮겨서 다른 클래스가 재사용한다.
+ *  - slab region 이 다 차면 작은 요청도 명시적 리스트로 간다.
+ *
+ * 명시적 리스트 쪽은 mm-explicit.c 와 같다.
+ * 모든 블록은 header를 가지며, 가용 블록만 추가로 footer와 prev free block pointer, next free block pointer를 가진다.
+ * 할당 블록에는 footer가 없다. 대신 header의 PREV_ALLOC 비트에 앞 블록의 할당 여부를 기록해서, 앞 블록이 가용일 때만 footer를 읽는다.
+ * 더블워드 정렬 기준이다. 블록의 최소 크기(바이트) 는 16 bytes 이다.
+ *
+ * NOTE TO STUDENTS: Replace this header comment with your own header
+ * comment that gives a high level description of your solution.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "mm.h"
+#include "memlib.h"
+
+/*********************************************************
+ * NOTE TO STUDENTS: Before you do anything else, please
+ * provide your team information in the following struct.
+ ********************************************************/
+team_t team = {
+    /* Team name */
+    "JUNGLE_W06_TEAM_7",
+    /* First member's full name */
+    "LEE_KANG_WOOK",
+    /* First member's email address */
+    "dlrkddnr0421@daum.net",
+    /* Second member’s full name (leave blank if none) */
+    "",
+    /* Second member’s email address (leave blank if none) */
+    ""
+};
+
+/* Basic constants and macros*/
+
+#define WSIZE       4       /* Word and header/footer size (bytes) */  
+#define DSIZE       8       /* Double word size (bytes) */
+#define MINBLKSIZE  16      /* minimum block size with header, free pointers and footer */  
+#define CHUNKSIZE  (1<<12)  /* Extend heap by this amout (bytes) */
+#ifndef ALIGNMENT
+#define ALIGNMENT   8       /* double word (8) alignment */
+#endif
+#if ALIGNMENT != 8
+#error "mm-slab.c supports only 8-byte alignment"
+#endif
+
+/* Slab constants */
+#define SLAB_PAGE           4096                    /* bytes per slab, also its alignment */
+#define SLAB_STEP           8                       /* slot size step between classes */
+#define SLAB_MAXSIZE        128                     /* largest request served from a slab */
+#define NUM_SLAB_CLASSES    (SLAB_MAXSIZE / SLAB_STEP)
+#define SLAB_MAP_WORDS      (SLAB_PAGE / SLAB_STEP / 32)    /* enough bits for the smallest slots */
+#define SLAB_REGION_SIZE    (1<<20)                 /* most bytes of slab pages, taken off the top of region 0 */
+
+#define MAX(x, y) ((x) > (y)? (x) : (y))
+
+/* Pack a size and allocated bits into a word */
+#define PACK(size, alloc)   ((size) | (alloc))
+#define PREV_ALLOC  0x2     /* header bit : previous block is allocated */
+
+/* Read and write a word at address p */
+#define GET(p) (*((unsigned int *)(p)))
+#define PUT(p, val) (*(unsigned int *)(p) = (val))
+
+/* Read the size and allocated fields from address p. (p would be an address of header or footer of block)*/
+#define GET_SIZE(p) (GET(p) & ~0x7)
+#define GET_ALLOC(p) (GET(p) & 0x1)
+#define GET_PREV_ALLOC(p) (GET(p) & PREV_ALLOC)
+#define UINT_CAST(p) ((size_t)p)
+
+/* Set or clear the PREV_ALLOC bit of the header at address p */
+#define SET_PREV_ALLOC(p)   PUT(p, GET(p) | PREV_ALLOC)
+#define CLR_PREV_ALLOC(p)   PUT(p, GET(p) & ~PREV_ALLOC)
+
+/* bp(block pointer) : payload의 시작 주소를 가리키는 포인터이다. 헤더를 가리키지 않는다. */
+/* Given block ptr bp(), compute address of its header and footer */
+#define HDRP(bp)        ((char *)(bp) - WSIZE)
+#define FTRP(bp)        ((char *)(bp) + GET_SIZE(HDRP(bp)) - DSIZE)     // 가용 블록에만 footer가 있다.
+
+/* Given block ptr bp, compute address of next and previous blocks */
+/* PREV_BLKP 는 앞 블록의 footer를 읽으므로, GET_PREV_ALLOC 으로 앞 블록이 가용임을 확인한 뒤에만 쓸 수 있다. */
+#define NEXT_BLKP(bp)   ((char *)(bp) + GET_SIZE(((char *)(bp) - WSIZE)))
+#define PREV_BLKP(bp)   ((char *)(bp) - GET_SIZE(((char *)(bp) - DSIZE)))
+
+/* Given free block ptr bp, compute address of previous and next free blocks */
+#define NEXT_FREE(bp)   ((void *)((char *)bp))                
+#define PREV_FREE(bp)   ((void *)((char *)bp + WSIZE))
+
+/* Read and write a free-list link at address p : 32-bit offset from link_base, 0 is NULL */
+#define GET_LINK(p)         ((void *)(GET(p) ? link_base + GET(p) : NULL))
+#define PUT_LINK(p, ptr)    PUT(p, (ptr) ? (unsigned int)((char *)(ptr) - link_base) : 0)
+// bp로부터 4바이트는 next free block 의 offset 을 담고있다. 64비트에서도 링크는 한 워드이다.
+
+/* rounds up to the nearest multiple of ALIGNMENT */
+#define ALIGN(size) (((size) + (ALIGNMENT-1)) & ~0x7)       // 7을 더해주고 하위 3개의 비트는 0으로 바꿔줌.
+                                                            // 그러면 나보다 높으면서 가장 가까운 8의 배수가 될 수 있다.
+
+/* size class of a small request, and the slab holding a slot */
+#define SLAB_CLASS(size)    (((size) - 1) / SLAB_STEP)
+#define SLAB_OF(bp)         ((slab_t *)(UINT_CAST(bp) & ~(SLAB_PAGE - 1)))
+#define SLAB_SLOTS(s)       ((char *)(s) + SLAB_HDRSIZE)
+#define SLAB_HDRSIZE        ALIGN(sizeof(slab_t))
+#define IS_SLAB(bp)         (slab_lo != NULL && (char *)(bp) >= slab_lo && (char *)(bp) < slab_lo + SLAB_REGION_SIZE)
+
+/* heap checker */
+#ifdef DEBUG
+# define CHECKHEAP() printf("\n%s : %d\n", __func__,__LINE__); mm_checkheap(__LINE__);
+#endif
+
+/*
+ * slab_t - slab 페이지 맨 앞의 metadata. slot 들은 SLAB_HDRSIZE 부터 objsize 간격으로 놓인다.
+ */
+typedef struct slab {
+    struct slab *next, *prev;               /* partial list of its class, or empty_slabs */
+    unsigned short objsize;                 /* slot size (bytes) */
+    unsigned short nobjs;                   /* slots in the page */
+    unsigned short nfree;                   /* free slots */
+    unsigned short class;
+    unsigned int bitmap[SLAB_MAP_WORDS];    /* bit i set : slot i is free */
+} slab_t;
+
+/* private variables */
+static char *heap_listp;
+static void *root;
+static char *link_base;                     /* free-list links are offsets from here */
+static char *slab_lo;                           /* first byte of the slab region, NULL if there is none */
+static int slab_region;
+static slab_t *partial[NUM_SLAB_CLASSES];       /* slabs with at least one free slot, per class */
+static slab_t *empty_slabs;                     /* slabs with every slot free, any class */
+
+/* slab counters, reset by mm_init */
+static struct {
+    int pages;      /* pages taken from the slab region */
+    int allocs;     /* requests served from a slab */
+    int frees;      /* slots given back */
+    int spills;     /* small requests sent to the free list because the region was full */
+} slab_stats;
+
+/* mm_realloc path counters, reset by mm_init */
+static struct {
+    int shrink;     /* fits in the block itself */
+    int next;       /* grown into the next free block */
+    int extend;     /* grown at the heap tail by mem_sbrk */
+    int prev;       /* grown into the previous free block with memmove */
+    int copy;       /* fell back to malloc + memcpy + free */
+} realloc_stats;
+
+/* private function declarations */
+int mm_init(void);
+static void *extend_heap(size_t words);
+static void *find_fit(size_t asize);
+static void place(void *bp, size_t asize);
+static void *coalesce(void *bp);
+static void update_pointer(void *bp, void *prev, void *next);
+static void *insert_free(void *bp);
+static void remove_free(void *bp);
+static size_t adjust_size(size_t size);
+static void absorb_next(void *bp);
+static void split_block(void *bp, size_t asize);
+static void *slab_alloc(size_t size);
+static void slab_free(void *bp);
+static slab_t *slab_new(int class);
+static void slab_push(slab_t **head, slab_t *s);
+static void slab_unlink(slab_t **head, slab_t *s);
+static void mm_checkheap(int lineno);
+
+/* 
+ * mm_init - Initializes the heap like that shown below.
+ -------------------------------------------------------------------------------------------------------------
+ * <initialized heap image>
+ * @                          @                           @  - double word alignment
+ *  _____________ ____________ _____________ _____________
+ * |   PROLOGUE  |  PROLOGUE  |   PROLOGUE  |             |
+ * |     next    |    prev    |    footer   |   EPILOGUE  |
+ * |-------------|------------|-------------|-------------|
+ * |      0      |      0     |    4 / 1    |   0 / 1 1   |
+ * |-------------|------------|-------------|-------------|
+ *                                          ^
+ *                                      heap_listp
+ -------------------------------------------------------------------------------------------------------------
+ * <generalized heap image>
+ * @                          @                           @                           @                           @  - double word alignment
+ *  _____________ ____________ _____________                                                         _____________ 
+ * |   PROLOGUE  |  PROLOGUE  |   PROLOGUE  |                                                       |             |
+ * |     next    |    prev    |    footer   |                                                       |   EPILOGUE  |
+ * |-------------|------------|-------------|-------------|-------------|-------------|-------------|-------------|
+ * |      0      |      0     |    4 / 1    |    HEADER   |    PREV     |    NEXT     |    FOOTER   |    0 / 1    |
+ * |-------------|------------|-------------|-------------|-------------|-------------|-------------|-------------|
+ * ^                                        ^
+ * root                                 heap_listp
+ * 
+ * header 는 (size / PREV_ALLOC / alloc) 로 인코딩된다. 첫 번째 블록의 PREV_ALLOC 은 prologue 때문에 항상 1 이다.
+ */
+int mm_init(void)
+{
+    link_base = (char *)mem_heap_lo() - WSIZE;  // 힙 맨 앞 블록도 0 이 아닌 offset 을 갖도록 한 워드 앞에 둔다.
+    /* Create the initial empty heap */
+    if ((heap_listp = mem_sbrk(4*WSIZE)) == (void *)-1)     // 시스템에 요청한 heap공간 할당이 실패했을 때.
+        return -1;
+    PUT(heap_listp + 0*WSIZE, 0);                /* PROLOGUE next */
+    PUT(heap_listp + 1*WSIZE, 0);                /* PROLOGUE prev */
+    PUT(heap_listp + 2*WSIZE, PACK(4, 1));       /* PROLOGUE footer */
+    PUT(heap_listp + 3*WSIZE, PACK(0, PREV_ALLOC | 1));   /* EPILOGUE */
+    root = heap_listp;
+    heap_listp += 3*WSIZE;
+    memset(&realloc_stats, 0, sizeof(realloc_stats));
+
+    /* Carve the slab region. It starts on a page boundary, so SLAB_OF works. */
+    memset(partial, 0, sizeof(partial));
+    memset(&slab_stats, 0, sizeof(slab_stats));
+    empty_slabs = NULL;
+    slab_lo = NULL;
+    if ((slab_region = mem_region_new(SLAB_REGION_SIZE)) >= 0)
+        slab_lo = mem_region_lo(slab_region);
+
+    /* Extend the empty heap with a free block of CHUNKSIZE bytes */
+    if (extend_heap(CHUNKSIZE/WSIZE) == NULL)   // 필요한 워드의 개수를 인자로 넘긴다.
+        return -1;
+
+    return 0;
+}
+
+/*
+ * extend_heap은
+ * 1. 힙이 초기화 될 때, 또는
+ * 2.mm_malloc이 적당한 맞춤 fit을 찾지 못했을 때 호출된다.
+ */
+static void *extend_heap(size_t words) // size_t a.k.a. {long, unsigned int} (stddef.h)
+{
+    char *bp;
+    size_t size;
+    size_t prev_alloc;
+
+    /* Allocate an even number of words to maintain alignment */
+    size = (words % 2) ? (words+1) * WSIZE : words * WSIZE;     // 요청 크기를 2워드의 배수로 다시 맞춘다.
+    if ((long)(bp = mem_sbrk(size)) == -1)
+        return NULL;
+    prev_alloc = GET_PREV_ALLOC(HDRP(bp));  // 이전 epilogue header 에 기록돼 있던 마지막 블록의 할당 여부
+    /* Initialize free block header/footer and the epilogue header */
+    PUT(HDRP(bp), PACK(size, prev_alloc));  /* Free block header */     // 위에서 extend한 size가 encode 됨에 유의하자.
+    PUT(FTRP(bp), GET(HDRP(bp)));           /* Free block footer */
+    PUT(HDRP(NEXT_BLKP(bp)), PACK(0,1));    /* New epilogue header */   // 앞 블록(방금 만든 블록)은 가용이다.
+
+    /* Coalesce if the previous block was free block */
+    return coalesce(bp);
+}
+
+/* 
+ * mm_malloc - size 바이트의 메모리를 할당하고, 해당 블록의 포인터(bp)를 반환.
+ *           - 적절한 크기의 free 블록을 찾지 못한 경우, extend_heap 을 통해 힙을 확장 후 할당.
+ */
+void *mm_malloc(size_t size)
+{
+    size_t asize;       /* Adjusted block size for alignment */
+    size_t extendsize;  /* Amount to extend heap if no fit */
+    char *bp;
+
+    /* 불필요한 요청 무시 */
+    if (size == 0) {
+        return NULL;
+    }
+
+    /* 작은 요청은 slab 에서 */
+    if (size <= SLAB_MAXSIZE && (bp = slab_alloc(size)) != NULL)
+        return bp;
+
+    /* Adjust block size to include overhead and alignment reqs (double word). */
+    asize = adjust_size(size);
+
+    /* Search the free list for a fit */
+    if ((bp = find_fit(asize)) != NULL) {
+        place(bp, asize);
+
+        return bp;
+    }
+
+    /* No fit found. Get more memory and place the block */
+    extendsize = MAX(asize, CHUNKSIZE);
+    if ((bp = extend_heap(extendsize/WSIZE)) == NULL)
+        return NULL;
+
+    place(bp, asize);
+
+    return bp;
+}
+
+/*
+ * adjust_size - 요청 size 를 overhead 와 정렬을 포함한 블록 크기로 바꾼다.
+ */
+static size_t adjust_size(size_t size)
+{
+    if (size <= MINBLKSIZE - WSIZE)     // 요청된 size가 minimum block size에서 header의 크기 뺀, 최소 payload크기보다도 작으면
+        return MINBLKSIZE;              // 그냥 minimum block을 할당해주면 됨.
+    return ALIGN(size + WSIZE);         // size는 사용자가 요구한 공간. 할당 블록에는 footer가 없으므로 헤더 4바이트만 더해준다.
+}
+
+/*
+ * find_fit - find available free block for request.
+*/
+static void *find_fit(size_t asize)
+{   
+    // First-fit search
+    for (void *bp = GET_LINK(NEXT_FREE(root)); bp != NULL; bp = GET_LINK(NEXT_FREE(bp))) {
+        if (GET_SIZE(HDRP(bp)) >= asize)
+            return bp;
+    }
+    return NULL;
+}
+
+/*
+ * update_pointer - update pointers of bp, prev, next
+*/
+static void update_pointer(void *bp, void *prev, void *next) {
+    // 내 꺼
+    PUT_LINK(PREV_FREE(bp), prev);
+    PUT_LINK(NEXT_FREE(bp), next);
+    // 남의 꺼  
+    PUT_LINK(NEXT_FREE(prev), bp);
+    if (next)
+        PUT_LINK(PREV_FREE(next), bp);
+}
+
+/*
+ * place - place allocated block and divide if possible.
+ */
+static void place(void *bp, size_t asize)
+{
+    size_t original_size = GET_SIZE(HDRP(bp));  // 원래 블록의 사이즈
+    size_t prev_alloc = GET_PREV_ALLOC(HDRP(bp));
+    size_t diff = original_size - asize;
+    
+    if (diff >= MINBLKSIZE) {   // 원래 블록의 사이즈와 할당하려는 블록 사이즈의 차이가 블록의 최소크기 보다 커야 분할할 수 있다.
+
+        // 할당 처리
+        PUT(HDRP(bp) , PACK(asize, prev_alloc | 1));    // header (asize / prev_alloc / 1), footer 없음
+        void * leftover_bp = NEXT_BLKP(bp);
+        
+        // 남은 부분 가용 처리
+        PUT(HDRP(leftover_bp), PACK(diff, PREV_ALLOC)); // header (diff / 1 / 0)
+        PUT(FTRP(leftover_bp), PACK(diff, PREV_ALLOC)); // footer (diff / 1 / 0)
+
+        /* 포인터 조정 */
+        update_pointer(leftover_bp, GET_LINK(PREV_FREE(bp)), GET_LINK(NEXT_FREE(bp)));
+    }
+    else {  // 분할 못하는 경우.
+
+        // 원래 블록을 전부 할당 처리.
+        PUT(HDRP(bp), PACK(original_size, prev_alloc | 1));
+        SET_PREV_ALLOC(HDRP(NEXT_BLKP(bp)));            // 뒤 블록에게 내가 할당됐음을 알린다.
+
+        /* 포인터 조정 */
+        remove_free(bp);
+    }
+}
+
+/*
+ * remove_free - 가용 블록 bp 를 리스트에서 뺀다.
+ */
+static void remove_free(void *bp)
+{
+    // 남의 꺼만 하면 됨. 어떠한 포인터도 날 가리키지 않게되면 나는 리스트에서 삭제된 것임.
+    PUT(NEXT_FREE(GET_LINK(PREV_FREE(bp))), GET(NEXT_FREE(bp)));
+    if (GET(NEXT_FREE(bp)))
+        PUT(PREV_FREE(GET_LINK(NEXT_FREE(bp))), GET(PREV_FREE(bp)));
+}
+
+/*
+ * mm_free - 일단 현재 블록을 free해주고, coalese 를 통해 경우에 따라 인접한 블록들을 연결을 해준다.
+ */
+void mm_free(void *bp)
+{
+    if (IS_SLAB(bp)) {
+        slab_free(bp);
+        return;
+    }
+
+    size_t size = GET_SIZE(HDRP(bp));
+    PUT(HDRP(bp), PACK(size, GET_PREV_ALLOC(HDRP(bp))));    // size 그대로인 free 블록으로 지정.
+    PUT(FTRP(bp), GET(HDRP(bp)));                           // 가용 블록이 되었으니 footer 도 써준다.
+    CLR_PREV_ALLOC(HDRP(NEXT_BLKP(bp)));                    // 뒤 블록에게 내가 가용이 되었음을 알린다.
+    coalesce(bp);
+
+
+}
+
+/*
+ * insert_free - free된 블럭을 리스트 안에 삽입해야할 때 사용한다.
+*/
+static void *insert_free(void *bp) {
+    void * prev_free = root;
+    void * next_free = GET_LINK(NEXT_FREE(root));
+    while (next_free != NULL) {
+        if (bp < next_free)  // 찾았다!
+            break;
+        prev_free = next_free;
+        next_free = GET_LINK(NEXT_FREE(next_free));
+    }
+    update_pointer(bp, (void *)prev_free, (void *)next_free);
+    return bp;
+}
+
+static void *coalesce(void *bp)
+{
+    size_t prev_alloc = GET_PREV_ALLOC(HDRP(bp));           // 앞 블록의 할당 여부  // 앞 블록의 footer 대신 내 header 의 비트를 본다.
+    size_t next_alloc = GET_ALLOC(HDRP(NEXT_BLKP(bp)));     // 뒤 블록의 할당 여부
+    size_t size = GET_SIZE(HDRP(bp));                       // 현재 블록의 사이즈
+
+    /* case 1 : 앞, 뒤 블록 모두 allocated 인 경우. */
+    if (prev_alloc && next_alloc) {
+        insert_free(bp);
+    }
+    /* case 3 : 앞 블록만 free 인 경우. */
+    else if (next_alloc) {
+        size += GET_SIZE(HDRP(PREV_BLKP(bp)));
+        PUT(FTRP(bp), PACK(size, PREV_ALLOC));          // 가용 블록의 앞 블록은 항상 할당 블록이다.
+        PUT(HDRP(PREV_BLKP(bp)), PACK(size, PREV_ALLOC));
+        bp = PREV_BLKP(bp);
+        // prev free block은 이미 free list에 있던 블록이기 때문에,
+        // update_pointer 불필요.
+    }
+    /* case 2 : 뒤 블록만 free 인 경우. */
+    else if (prev_alloc) {
+        void * next_bp = NEXT_BLKP(bp);
+        size += GET_SIZE(HDRP(next_bp));
+        PUT(HDRP(bp), PACK(size, PREV_ALLOC));  // 현재 블록의 크기와 뒤 블록의 크기가 합쳐진 size가 현재 블록의 header에 인코딩됨.
+        PUT(FTRP(bp), PACK(size, PREV_ALLOC));  // 위 라인 덕분에 FTRP(bp) 는 다음 블록의 footer를 가리키게 된다.
+
+        update_pointer(bp, GET_LINK(PREV_FREE(next_bp)), GET_LINK(NEXT_FREE(next_bp)));
+    }
+
+    /* case 4 : 앞, 뒤 블록 모두 free 인 경우. */
+    else {
+        size += GET_SIZE(HDRP(PREV_BLKP(bp))) + GET_SIZE(FTRP(NEXT_BLKP(bp)));
+        PUT(HDRP(PREV_BLKP(bp)), PACK(size, PREV_ALLOC));
+        PUT(FTRP(NEXT_BLKP(bp)), PACK(size, PREV_ALLOC));
+        void *nnext_bp = NEXT_BLKP(bp); 
+        bp = PREV_BLKP(bp);
+
+        update_pointer(bp, GET_LINK(PREV_FREE(bp)), GET_LINK(NEXT_FREE(nnext_bp)));
+    }
+    return bp;
+}
+
+/*
+ * mm_realloc - 가능하면 블록을 제자리에서 늘리거나 줄이고, 안 될 때만 mm_malloc + memcpy + mm_free 를 한다.
+ *            - 다음 순서로 시도한다.
+ *              1. 줄이기       : 요청이 지금 블록에 들어가면 남는 부분만 잘라서 가용 리스트로 돌려준다.
+ *              2. 뒤 블록 흡수  : 뒤 블록이 가용이고 합친 크기가 충분하면 뒤 블록을 흡수한다.
+ *              3. 힙 끝 확장    : 내가 (뒤의 가용 블록을 포함해서) epilogue 바로 앞 블록이면 모자란 만큼만 mem_sbrk 한다.
+ *              4. 앞 블록 흡수  : 앞 블록이 가용이고 (뒤 블록까지) 합친 크기가 충분하면, 앞으로 payload 를 memmove 한다.
+ *              5. 복사         : 위가 모두 안 되면 새로 할당해서 복사한다.
+ *            - 각 경로를 탄 횟수는 realloc_stats 에 세고, mm_report 로 출력한다.
+ */
+void *mm_realloc(void *bp, size_t size)
+{
+    void *newptr;
+    void *next_bp, *prev_bp;
+    size_t asize;
+    size_t old_size, next_size, prev_size;
+    size_t copySize;
+
+    if (bp == NULL)
+        return mm_malloc(size);
+    if (size == 0) {
+        mm_free(bp);
+        return NULL;
+    }
+
+    /* slab 의 slot 은 늘릴 수 없다. 들어가면 그대로, 아니면 옮긴다. */
+    if (IS_SLAB(bp)) {
+        copySize = SLAB_OF(bp)->objsize;
+        if (size <= copySize) {
+            realloc_stats.shrink++;
+            return bp;
+        }
+        realloc_stats.copy++;
+        if ((newptr = mm_malloc(size)) == NULL)
+            return NULL;
+        memcpy(newptr, bp, copySize);
+        slab_free(bp);
+        return newptr;
+    }
+
+    asize = adjust_size(size);
+    old_size = GET_SIZE(HDRP(bp));
+    next_bp = NEXT_BLKP(bp);
+    next_size = GET_ALLOC(HDRP(next_bp)) ? 0 : GET_SIZE(HDRP(next_bp));    // 뒤 블록이 가용일 때만 쓸 수 있는 크기
+
+    /* 1. 줄이기 (또는 그대로) */
+    if (asize <= old_size) {
+        realloc_stats.shrink++;
+        split_block(bp, asize);
+        return bp;
+    }
+
+    /* 2. 뒤 블록 흡수 */
+    if (old_size + next_size >= asize) {
+        realloc_stats.next++;
+        absorb_next(bp);
+        split_block(bp, asize);
+        return bp;
+    }
+
+    /* 3. 힙 끝 확장 */
+    if (GET_SIZE(HDRP(next_size ? NEXT_BLKP(next_bp) : next_bp)) == 0) {     // 그 다음이 epilogue 이다.
+        size_t extendsize = asize - old_size - next_size;
+
+        if (mem_sbrk(extendsize) != (void *)-1) {
+            realloc_stats.extend++;
+            if (next_size)
+                absorb_next(bp);
+            PUT(HDRP(bp), PACK(asize, GET_PREV_ALLOC(HDRP(bp)) | 1));
+            PUT(HDRP(NEXT_BLKP(bp)), PACK(0, PREV_ALLOC | 1));          /* New epilogue header */
+            return bp;
+        }
+    }
+
+    /* 4. 앞 블록 흡수 */
+    prev_size = GET_PREV_ALLOC(HDRP(bp)) ? 0 : GET_SIZE(bp - DSIZE);      // 앞 블록이 가용이면 footer 에서 크기를 읽는다.
+    if (prev_size + old_size + next_size >= asize) {
+        size_t total = prev_size + old_size;
+
+        realloc_stats.prev++;
+        prev_bp = PREV_BLKP(bp);
+        if (prev_size + old_size < asize) {     // 앞 블록만으로 모자라면 뒤 블록까지 흡수한다.
+            remove_free(next_bp);
+            total += next_size;
+        }
+        remove_free(prev_bp);                   // 리스트 포인터가 덮어써지기 전에 먼저 뺀다.
+        PUT(HDRP(prev_bp), PACK(total, GET_PREV_ALLOC(HDRP(prev_bp)) | 1));
+        memmove(prev_bp, bp, old_size - WSIZE);
+        SET_PREV_ALLOC(HDRP(NEXT_BLKP(prev_bp)));
+        split_block(prev_bp, asize);
+        return prev_bp;
+    }
+
+    /* 5. 복사 */
+    realloc_stats.copy++;
+    newptr = mm_malloc(size);       // size : 사용자 요청 크기
+    if (newptr == NULL)
+      return NULL;
+    copySize = old_size - WSIZE;    // 할당 블록의 payload 는 header 를 뺀 나머지 전부.
+    if (size < copySize)
+      copySize = size;
+    memcpy(newptr, bp, copySize);
+
+    mm_free(bp);
+    return newptr;
+}
+
+/*
+ * absorb_next - 할당 블록 bp 뒤의 가용 블록을 리스트에서 빼고 bp 에 합친다.
+ */
+static void absorb_next(void *bp)
+{
+    void *next_bp = NEXT_BLKP(bp);
+    size_t size = GET_SIZE(HDRP(bp)) + GET_SIZE(HDRP(next_bp));
+
+    remove_free(next_bp);
+    PUT(HDRP(bp), PACK(size, GET_PREV_ALLOC(HDRP(bp)) | 1));
+    SET_PREV_ALLOC(HDRP(NEXT_BLKP(bp)));        // 가용 블록의 뒤 블록이었으니 PREV_ALLOC 이 꺼져 있었다.
+}
+
+/*
+ * split_block - 할당 블록 bp 를 asize 로 줄이고, 남는 부분이 최소 블록 이상이면 가용 블록으로 돌려준다.
+ */
+static void split_block(void *bp, size_t asize)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    size_t diff = size - asize;
+    void *leftover_bp;
+
+    if (diff < MINBLKSIZE)
+        return;
+
+    PUT(HDRP(bp), PACK(asize, GET_PREV_ALLOC(HDRP(bp)) | 1));
+    leftover_bp = NEXT_BLKP(bp);
+    PUT(HDRP(leftover_bp), PACK(diff, PREV_ALLOC));
+    PUT(FTRP(leftover_bp), PACK(diff, PREV_ALLOC));
+    CLR_PREV_ALLOC(HDRP(NEXT_BLKP(leftover_bp)));
+    coalesce(leftover_bp);                      // 뒤 블록이 가용이면 합쳐진다.
+}
+
+/*
+ * slab_alloc - size 가 속한 클래스의 slab 에서 가용 slot 하나를 꺼낸다. slab region 이 다 찼으면 NULL.
+ */
+static void *slab_alloc(size_t size)
+{
+    int class = SLAB_CLASS(size);
+    slab_t *s = partial[class];
+    int i, bit;
+
+    if (s == NULL) {
+        if ((s = slab_new(class)) == NULL) {
+            slab_stats.spills++;
+            return NULL;
+        }
+        slab_push(&partial[class], s);
+    }
+
+    for (i = 0; s->bitmap[i] == 0; i++)     // partial 에 있는 slab 은 가용 slot 이 반드시 있다.
+        ;
+    bit = __builtin_ctz(s->bitmap[i]);
+    s->bitmap[i] &= ~(1u << bit);
+    if (--s->nfree == 0)                    // 다 찼으면 partial 에서 뺀다.
+        slab_unlink(&partial[class], s);
+    slab_stats.allocs++;
+    return SLAB_SLOTS(s) + (i * 32 + bit) * s->objsize;
+}
+
+/*
+ * slab_free - slot 을 bitmap 에 돌려준다. 페이지 경계로 내림한 주소가 그 slot 의 slab_t 이다.
+ */
+static void slab_free(void *bp)
+{
+    slab_t *s = SLAB_OF(bp);
+    int idx = ((char *)bp - SLAB_SLOTS(s)) / s->objsize;
+
+    s->bitmap[idx / 32] |= 1u << (idx % 32);
+    if (s->nfree++ == 0)                    // 꽉 차 있었으면 다시 partial 로.
+        slab_push(&partial[s->class], s);
+    if (s->nfree == s->nobjs) {             // 다 비었으면 다른 클래스도 쓸 수 있게 empty_slabs 로.
+        slab_unlink(&partial[s->class], s);
+        slab_push(&empty_slabs, s);
+    }
+    slab_stats.frees++;
+}
+
+/*
+ * slab_new - 빈 slab 을 하나 가져와 class 의 slot 들로 나눈다. empty_slabs 에 없으면 slab region 에서 한 페이지 떼어 온다.
+ */
+static slab_t *slab_new(int class)
+{
+    slab_t *s;
+    int n;
+
+    if ((s = empty_slabs) != NULL)
+        slab_unlink(&empty_slabs, s);
+    else {
+        if (slab_lo == NULL || (char *)mem_region_hi(slab_region) + 1 + SLAB_PAGE > slab_lo + SLAB_REGION_SIZE)
+            return NULL;    // region 이 다 찼다.
+        s = mem_region_sbrk(slab_region, SLAB_PAGE);
+        slab_stats.pages++;
+    }
+
+    s->class = class;
+    s->objsize = (class + 1) * SLAB_STEP;
+    s->nobjs = s->nfree = (SLAB_PAGE - SLAB_HDRSIZE) / s->objsize;
+    memset(s->bitmap, 0, sizeof(s->bitmap));
+    for (n = 0; n + 32 <= s->nobjs; n += 32)
+        s->bitmap[n / 32] = ~0u;
+    if (n < s->nobjs)
+        s->bitmap[n / 32] = (1u << (s->nobjs - n)) - 1;
+    return s;
+}
+
+/*
+ * slab_push, slab_unlink - slab 이중 연결 리스트의 맨 앞에 넣기, 아무 데서나 빼기.
+ */
+static void slab_push(slab_t **head, slab_t *s)
+{
+    s->prev = NULL;
+    s->next = *head;
+    if (*head)
+        (*head)->prev = s;
+    *head = s;
+}
+
+static void slab_unlink(slab_t **head, slab_t *s)
+{
+    if (s->prev)
+        s->prev->next = s->next;
+    else
+        *head = s->next;
+    if (s->next)
+        s->next->prev = s->prev;
+}
+
+/*
+ * mm_memalign - this engine has no aligned placement. Alignments up to ALIGNMENT are plain mm_malloc;
+ *               larger ones fail with a message instead of padding the block by a whole alignment.
+ */
+void *mm_memalign(size_t alignment, size_t size)
+{
+    return mm_memalign_offset(alignment, 0, size);
+}
+
+/*
+ * mm_memalign_offset - same as mm_memalign, for payload + offset. Every payload is ALIGNMENT-aligned, so offset must be a multiple of it.
+ */
+void *mm_memalign_offset(size_t alignment, size_t offset, size_t size)
+{
+    if (alignment <= ALIGNMENT && offset % ALIGNMENT == 0)
+        return mm_malloc(size);
+    fprintf(stderr, "ERROR: mm_memalign(%u) failed. mm-slab.c has no aligned placement...\n", (unsigned int)alignment);
+    return NULL;
+}
+
+/*
+ * mm_free_sized - SLAB_MAXSIZE 이하 요청의 slot 은 header 를 보지 않고 바로 slab_free 로 돌려준다.
+ *               - 작은 요청도 slab region 이 차면 힙에서 받으므로 (spill) IS_SLAB 주소 검사는 남는다.
+ *               - 그보다 큰 요청은 slab 에 있을 수 없다. 힙 블록은 coalesce 하려면 header 를 읽어야 하므로 mm_free 와 같다.
+ */
+void mm_free_sized(void *ptr, size_t size)
+{
+    if (size <= SLAB_MAXSIZE && IS_SLAB(ptr)) {
+        slab_free(ptr);
+        return;
+    }
+    mm_free(ptr);
+}
+
+/*
+ * mm_usable_size - payload bytes of the block at ptr, at least the size it was requested with.
+ */
+size_t mm_usable_size(void *ptr)
+{
+    if (IS_SLAB(ptr))
+        return SLAB_OF(ptr)->objsize;
+    return GET_SIZE(HDRP(ptr)) - WSIZE;
+}
+
+/*
+ * mm_malloc_batch - this engine has no batch path; n calls to mm_malloc. Returns how many succeeded.
+ */
+size_t mm_malloc_batch(size_t size, size_t n, void **out)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if ((out[i] = mm_malloc(size)) == NULL)
+            break;
+    return i;
+}
+
+/*
+ * mm_free_batch - this engine has no batch path; n calls to mm_free.
+ */
+void mm_free_batch(void **ptrs, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        mm_free(ptrs[i]);
+}
+
+/*
+ * mm_set_place - this engine has one placement; the rule is ignored.
+ */
+void mm_set_place(size_t size, int end)
+{
+}
+
+/*
+ * mm_set_fit - this engine has one fit policy; the policy is ignored.
+ */
+void mm_set_fit(int policy)
+{
+}
+
+/*
+ * mm_malloc_flags - this engine takes no placement hints; mm_malloc, with the payload cleared for MALLOC_ZERO.
+ */
+void *mm_malloc_flags(size_t size, int flags, void *near)
+{
+    void *p = mm_malloc(size);
+
+    if (p != NULL && (flags & MALLOC_ZERO))
+        memset(p, 0, size);
+    return p;
+}
+
+/*
+ * mm_report - print slab usage and how often each mm_realloc path was taken since mm_init.
+ */
+void mm_report(void)
+{
+    printf("slab: %d pages, %d allocs, %d frees, %d spilled to the free list\n",
+           slab_stats.pages, slab_stats.allocs, slab_stats.frees, slab_stats.spills);
+    printf("realloc: %d shrink, %d next, %d extend, %d prev (in place) / %d copy\n",
+           realloc_stats.shrink, realloc_stats.next, realloc_stats.extend,
+           realloc_stats.prev, realloc_stats.copy);
+}
+
+/*
+ * mm_checkheap - check heap invariants for this implementation.
+ *
+ * #ifdef DEBUG
+ *   CHECKHEAP();
+ * #endif
+*/
+void mm_checkheap(int lineno)
+{
+    char *heap_lo = mem_heap_lo();                      // pointing first word of the heap
+    char *heap_hi = (char *)mem_heap_hi() + 1 - WSIZE;  // pointing last word of the heap (region 0)
+    char *bp;
+
+    /* heap level check*/
+    //assert(GET(heap_lo) == 0);                          // check PROLOGUE next
+    //assert(GET(heap_lo + 1*WSIZE) == 0);                // check PROLOGUE prev
+    assert(GET(heap_lo + 2*WSIZE) == PACK(WSIZE,1));    // check PROLOGUE footer
+    assert(GET_SIZE(heap_hi) == 0 && GET_ALLOC(heap_hi));           // check epilogue block
+
+    /* block level */
+    // prologue footer (4/1) 의 크기는 GET_SIZE 로 읽으면 0 이므로, 첫 번째 블록부터 순회한다.
+    size_t prev_alloc = PREV_ALLOC;                 // 첫 번째 블록의 앞은 prologue
+    for(bp = heap_listp + WSIZE ; GET_SIZE(HDRP(bp)) > 0 ; bp = NEXT_BLKP(bp)) {
+        if (!GET_ALLOC(HDRP(bp)))
+            assert(GET(HDRP(bp)) == GET(FTRP(bp)));     // check header and footer match (free block only)
+        assert(GET_PREV_ALLOC(HDRP(bp)) == prev_alloc); // check PREV_ALLOC bit
+        assert(!(UINT_CAST(bp) & 0x7));             // check if payload area aligned
+        assert(GET_ALLOC(HDRP(bp)) | GET_ALLOC(HDRP(NEXT_BLKP(bp))));   // check contiguous free blocks
+        assert(heap_lo < HDRP(bp) && NEXT_BLKP(bp) - DSIZE < heap_hi);  // check heap bound
+        prev_alloc = GET_ALLOC(HDRP(bp)) ? PREV_ALLOC : 0;
+
+        // check all free blocks are in the free list
+        if (!GET_ALLOC(HDRP(bp))) {
+            void *next_free;
+            for (next_free = GET_LINK(NEXT_FREE(root)); next_free != NULL; next_free = GET_LINK(NEXT_FREE(next_free))) {
+                if (next_free == bp)
+                    break;
+            }
+            assert(next_free);
+        }
+    }
+    // detect cycle
+    char * hare; char *tortoise;
+    hare = tortoise = root;
+    printf("hare : %16p, tortoise: %16p\n", hare, tortoise);
+    while(1) {
+        if (!hare || !GET(NEXT_FREE(hare)))
+            break;
+        hare = GET_LINK(NEXT_FREE(GET_LINK(NEXT_FREE(hare))));
+        tortoise = GET_LINK(NEXT_FREE(tortoise));
+        printf("hare : %16p, tortoise: %16p\n", hare, tortoise);
+        assert(hare != tortoise);
+    }
+    /* list level check */
+    printf("<<free block list>>\n");
+    void * free = root;
+    void * next_free = GET_LINK(NEXT_FREE(root));
+    while (next_free != NULL) {
+        printf("free : %p, next free : %p\n", free, next_free);
+        assert(!GET_ALLOC(HDRP(next_free)));
+        assert(free < next_free);
+
+        free = next_free;
+        next_free = GET_LINK(NEXT_FREE(next_free));
+    }
+
+    /* slab level check */
+    if (slab_lo != NULL) {
+        char *slab_end = (char *)mem_region_hi(slab_region) + 1;
+        int class, i, nfree, listed = 0, full = 0;
+        slab_t *s;
+
+        assert(!(UINT_CAST(slab_lo) & (SLAB_PAGE - 1)));           // check slab region is page aligned
+        for (s = (slab_t *)slab_lo; (char *)s < slab_end; s = (slab_t *)((char *)s + SLAB_PAGE)) {
+            for (nfree = 0, i = 0; i < SLAB_MAP_WORDS; i++)
+                nfree += __builtin_popcount(s->bitmap[i]);
+            assert(nfree == s->nfree && nfree <= s->nobjs);         // check bitmap matches the free count
+            assert(SLAB_HDRSIZE + s->nobjs * s->objsize <= SLAB_PAGE);
+            full += (s->nfree == 0);
+        }
+        for (class = 0; class < NUM_SLAB_CLASSES; class++)
+            for (s = partial[class]; s != NULL; s = s->next, listed++) {
+                assert(s->class == class && s->objsize == (class + 1) * SLAB_STEP);
+                assert(0 < s->nfree && s->nfree < s->nobjs);    // neither full nor empty
+                assert(s->next == NULL || s->next->prev == s);  // check back link
+            }
+        for (s = empty_slabs; s != NULL; s = s->next, listed++)
+            assert(s->nfree == s->nobjs);
+        assert(listed + full == (slab_end - slab_lo) / SLAB_PAGE);  // every slab is listed exactly once, or full
+    }
+}
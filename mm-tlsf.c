@@ -0,0 +1,655 @@
+/*
+ * mm-tlsf.c - TLSF (two-level segregated fit), w/ LIFO order, immediate boundary-tag coalescing.
+ *
+ * 가용 블록을 2단계 크기 클래스로 나누어 관리하는 할당기. malloc 과 free 가 모두 O(1) 이다.
+ * 1단계(first level) 는 2의 거듭제곱 구간 [2^f, 2^(f+1)) 이고, 2단계(second level) 는 그 구간을 SL_COUNT 개로 등분한다.
+ * 각 (f, s) 클래스는 LIFO 명시적 가용 리스트를 가지며, 비어있지 않은 리스트는 fl_bitmap / sl_bitmap 의 비트로 표시된다.
+ * 요청 크기를 다음 클래스 경계로 올림한 뒤 find-first-set 으로 비트맵을 찾으므로, 찾은 리스트의 첫 블록은 항상 요청보다 크다.
+ * 모든 블록은 header와 footer을 가지며, 가용 블록은 추가로 prev free block pointer와 next free block pointer를 가진다.
+ * 더블워드 정렬 기준이다. 블록의 최소 크기(바이트) 는 16 bytes 이다.
+ *
+ * NOTE TO STUDENTS: Replace this header comment with your own header
+ * comment that gives a high level description of your solution.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <assert.h>
+#include <unistd.h>
+#include <string.h>
+
+#include "mm.h"
+#include "memlib.h"
+
+/*********************************************************
+ * NOTE TO STUDENTS: Before you do anything else, please
+ * provide your team information in the following struct.
+ ********************************************************/
+team_t team = {
+    /* Team name */
+    "JUNGLE_W06_TEAM_7",
+    /* First member's full name */
+    "LEE_KANG_WOOK",
+    /* First member's email address */
+    "dlrkddnr0421@daum.net",
+    /* Second member’s full name (leave blank if none) */
+    "",
+    /* Second member’s email address (leave blank if none) */
+    ""
+};
+
+/* Basic constants and macros*/
+
+#define WSIZE       4       /* Word and header/footer size (bytes) */
+#define DSIZE       8       /* Double word size (bytes) */
+#define MINBLKSIZE  16      /* minimum block size with header and footer */
+#define CHUNKSIZE  (1<<12)  /* Extend heap by this amout (bytes) */
+#ifndef ALIGNMENT
+#define ALIGNMENT   8       /* double word (8) alignment */
+#endif
+#if ALIGNMENT != 8
+#error "mm-tlsf.c supports only 8-byte alignment"
+#endif
+
+/* TLSF constants */
+#define SL_COUNT_LOG2   4                           /* log2 of number of second level lists per first level */
+#define SL_COUNT        (1 << SL_COUNT_LOG2)
+#define FL_SHIFT        (SL_COUNT_LOG2 + 3)         /* sizes below 2^FL_SHIFT (128) share first level 0, 8 bytes per list */
+#define SMALL_BLKSIZE   (1 << FL_SHIFT)
+#define FL_COUNT        20                          /* enough for blocks up to 2^(FL_SHIFT+FL_COUNT-2), far over MAX_HEAP */
+
+#define MAX(x, y) ((x) > (y)? (x) : (y))
+
+/* Pack a size and allocated bit into a word */
+#define PACK(size, alloc)   ((size) | (alloc))
+
+/* Read and write a word at address p */
+#define GET(p) (*((unsigned int *)(p)))
+#define PUT(p, val) (*(unsigned int *)(p) = (val))
+
+/* Read the size and allocated fields from address p. (p would be an address of header or footer of block)*/
+#define GET_SIZE(p) (GET(p) & ~0x7)
+#define GET_ALLOC(p) (GET(p) & 0x1)
+#define UINT_CAST(p) ((size_t)p)
+
+/* bp(block pointer) : payload의 시작 주소를 가리키는 포인터이다. 헤더를 가리키지 않는다. */
+/* Given block ptr bp(), compute address of its header and footer */
+#define HDRP(bp)        ((char *)(bp) - WSIZE)
+#define FTRP(bp)        ((char *)(bp) + GET_SIZE(HDRP(bp)) - DSIZE)
+
+/* Given block ptr bp, compute address of next and previous blocks */
+#define NEXT_BLKP(bp)   ((char *)(bp) + GET_SIZE(((char *)(bp) - WSIZE)))
+#define PREV_BLKP(bp)   ((char *)(bp) - GET_SIZE(((char *)(bp) - DSIZE)))
+
+/* Given free block ptr bp, compute address of previous and next free blocks */
+#define NEXT_FREE(bp)   ((void *)((char *)bp))
+#define PREV_FREE(bp)   ((void *)((char *)bp + WSIZE))
+
+/* Read and write a free-list link at address p : 32-bit offset from link_base, 0 is NULL */
+#define GET_LINK(p)         ((void *)(GET(p) ? link_base + GET(p) : NULL))
+#define PUT_LINK(p, ptr)    PUT(p, (ptr) ? (unsigned int)((char *)(ptr) - link_base) : 0)
+
+/* find-first-set / find-last-set on a non-zero word (bit index, origin 0) */
+#define FFS(x)  (__builtin_ffs(x) - 1)
+#define FLS(x)  (31 - __builtin_clz(x))
+
+/* rounds up to the nearest multiple of ALIGNMENT */
+#define ALIGN(size) (((size) + (ALIGNMENT-1)) & ~0x7)       // 7을 더해주고 하위 3개의 비트는 0으로 바꿔줌.
+                                                            // 그러면 나보다 높으면서 가장 가까운 8의 배수가 될 수 있다.
+
+/* heap checker */
+#ifdef DEBUG
+# define CHECKHEAP() printf("\n%s : %d\n", __func__,__LINE__); mm_checkheap(__LINE__);
+#endif
+
+/* TLSF control structure. 힙의 맨 앞(prologue 앞)에 놓인다. */
+typedef struct {
+    unsigned int fl_bitmap;                 /* bit f : some list of first level f is non-empty */
+    unsigned int sl_bitmap[FL_COUNT];       /* bit s of sl_bitmap[f] : list (f, s) is non-empty */
+    void *blocks[FL_COUNT][SL_COUNT];       /* list (f, s) 의 첫 번째 가용 블록 */
+} control_t;
+
+#define CTRLSIZE    ALIGN(sizeof(control_t))
+
+/* private variables */
+static char *heap_listp;
+static control_t *ctrl;
+static char *link_base;                     /* free-list links are offsets from here */
+
+/* private function declarations */
+int mm_init(void);
+static void *extend_heap(size_t words);
+static void mapping_insert(size_t size, int *fl, int *sl);
+static void mapping_search(size_t size, int *fl, int *sl);
+static void *find_fit(size_t asize);
+static void place(void *bp, size_t asize);
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset);
+static void place_aligned(void *bp, char *p, size_t asize);
+static void *coalesce(void *bp);
+static void insert_free(void *bp);
+static void remove_free(void *bp);
+static void mm_checkheap(int lineno);
+
+/*
+ * mm_init - Initializes the heap like that shown below.
+ -------------------------------------------------------------------------------------------------------------
+ * @                                        @                           @  - double word alignment
+ *  _______________________________________ _____________ _____________
+ * |                control                |   PROLOGUE  |             |
+ * | fl_bitmap | sl_bitmap[] | blocks[][]  |    footer   |   EPILOGUE  |
+ * |---------------------------------------|-------------|-------------|
+ * |          all zero (+ padding)         |    4 / 1    |    0 / 1    |
+ * |---------------------------------------|-------------|-------------|
+ * ^                                                     ^
+ * ctrl                                              heap_listp
+ -------------------------------------------------------------------------------------------------------------
+ * CTRLSIZE 는 8의 배수이므로 첫 번째 블록의 payload 도 8바이트 정렬된다.
+ */
+int mm_init(void)
+{
+    link_base = (char *)mem_heap_lo() - WSIZE;  // 힙 맨 앞 블록도 0 이 아닌 offset 을 갖도록 한 워드 앞에 둔다.
+    /* Create the initial empty heap */
+    if ((ctrl = mem_sbrk(CTRLSIZE + 2*WSIZE)) == (void *)-1)     // 시스템에 요청한 heap공간 할당이 실패했을 때.
+        return -1;
+    memset(ctrl, 0, CTRLSIZE);                          /* all lists empty */
+    heap_listp = (char *)ctrl + CTRLSIZE;
+    PUT(heap_listp + 0*WSIZE, PACK(4, 1));              /* PROLOGUE footer */
+    PUT(heap_listp + 1*WSIZE, PACK(0, 1));              /* EPILOGUE */
+    heap_listp += WSIZE;
+
+    /* Extend the empty heap with a free block of CHUNKSIZE bytes */
+    if (extend_heap(CHUNKSIZE/WSIZE) == NULL)   // 필요한 워드의 개수를 인자로 넘긴다.
+        return -1;
+
+    return 0;
+}
+
+/*
+ * extend_heap은
+ * 1. 힙이 초기화 될 때, 또는
+ * 2.mm_malloc이 적당한 맞춤 fit을 찾지 못했을 때 호출된다.
+ */
+static void *extend_heap(size_t words)
+{
+    char *bp;
+    size_t size;
+
+    /* Allocate an even number of words to maintain alignment */
+    size = (words % 2) ? (words+1) * WSIZE : words * WSIZE;     // 요청 크기를 2워드의 배수로 다시 맞춘다.
+    if ((long)(bp = mem_sbrk(size)) == -1)
+        return NULL;
+    /* Initialize free block header/footer and the epilogue header */
+    PUT(HDRP(bp), PACK(size, 0));           /* Free block header */
+    PUT(FTRP(bp), PACK(size, 0));           /* Free block footer */
+    PUT(HDRP(NEXT_BLKP(bp)), PACK(0,1));    /* New epilogue header */
+
+    /* Coalesce if the previous block was free block */
+    return coalesce(bp);
+}
+
+/*
+ * mapping_insert - 블록 크기 size 가 들어갈 리스트 (fl, sl) 를 계산한다.
+ */
+static void mapping_insert(size_t size, int *fl, int *sl)
+{
+    int f, s;
+
+    if (size < SMALL_BLKSIZE) {
+        // 작은 블록은 first level 0 에 모으고, 8바이트 단위로 second level 을 나눈다.
+        f = 0;
+        s = size / (SMALL_BLKSIZE / SL_COUNT);
+    }
+    else {
+        f = FLS(size);
+        s = (size >> (f - SL_COUNT_LOG2)) ^ (1 << SL_COUNT_LOG2);  // 최상위 비트 바로 아래 SL_COUNT_LOG2 비트
+        f -= (FL_SHIFT - 1);
+    }
+    *fl = f;
+    *sl = s;
+}
+
+/*
+ * mapping_search - size 를 다음 리스트 경계로 올림해서 (fl, sl) 을 계산한다.
+ *                - 이렇게 찾은 리스트에 있는 블록은 어느 것이든 size 이상임이 보장된다.
+ */
+static void mapping_search(size_t size, int *fl, int *sl)
+{
+    if (size >= SMALL_BLKSIZE)
+        size += (1 << (FLS(size) - SL_COUNT_LOG2)) - 1;
+    mapping_insert(size, fl, sl);
+}
+
+/*
+ * mm_malloc - size 바이트의 메모리를 할당하고, 해당 블록의 포인터(bp)를 반환.
+ *           - 적절한 크기의 free 블록을 찾지 못한 경우, extend_heap 을 통해 힙을 확장 후 할당.
+ */
+void *mm_malloc(size_t size)
+{
+    size_t asize;       /* Adjusted block size for alignment */
+    size_t extendsize;  /* Amount to extend heap if no fit */
+    char *bp;
+
+    /* 불필요한 요청 무시 */
+    if (size == 0) {
+        return NULL;
+    }
+
+    /* Adjust block size to include overhead and alignment reqs (double word). */
+    if (size <= MINBLKSIZE - DSIZE)
+        asize = MINBLKSIZE;
+    else
+        asize = ALIGN(size) + DSIZE;
+
+    /* Search the free lists for a fit */
+    if ((bp = find_fit(asize)) != NULL) {
+        place(bp, asize);
+
+        return bp;
+    }
+
+    /* No fit found. Get more memory and place the block */
+    extendsize = MAX(asize, CHUNKSIZE);
+    if ((bp = extend_heap(extendsize/WSIZE)) == NULL)
+        return NULL;
+
+    place(bp, asize);
+
+    return bp;
+}
+
+/*
+ * find_fit - find available free block for request in O(1).
+ *          - 먼저 asize 가 속한 리스트의 첫 블록만 확인한다. 올림 때문에 버려지는 딱 맞는 블록을 살리기 위함.
+ *          - 그 다음 sl_bitmap 에서 (fl, sl) 이상인 리스트를 찾고, 없으면 fl_bitmap 에서 더 큰 first level 을 찾는다.
+*/
+static void *find_fit(size_t asize)
+{
+    int fl, sl;
+    unsigned int sl_map, fl_map;
+
+    mapping_insert(asize, &fl, &sl);
+    if (fl >= FL_COUNT)
+        return NULL;
+    if (ctrl->blocks[fl][sl] && GET_SIZE(HDRP(ctrl->blocks[fl][sl])) >= asize)
+        return ctrl->blocks[fl][sl];
+
+    mapping_search(asize, &fl, &sl);
+    if (fl >= FL_COUNT)
+        return NULL;
+
+    sl_map = ctrl->sl_bitmap[fl] & (~0U << sl);
+    if (!sl_map) {
+        // 같은 first level 에 없으면, 더 큰 first level 중 가장 작은 것.
+        fl_map = (fl + 1 < 32) ? ctrl->fl_bitmap & (~0U << (fl + 1)) : 0;
+        if (!fl_map)
+            return NULL;
+        fl = FFS(fl_map);
+        sl_map = ctrl->sl_bitmap[fl];
+    }
+    sl = FFS(sl_map);
+
+    return ctrl->blocks[fl][sl];
+}
+
+/*
+ * place - place allocated block and divide if possible.
+ *       - 블록을 리스트에서 빼고, 남는 부분은 그 크기에 맞는 리스트에 다시 넣는다.
+ */
+static void place(void *bp, size_t asize)
+{
+    size_t original_size = GET_SIZE(HDRP(bp));  // 원래 블록의 사이즈
+    size_t diff = original_size - asize;
+
+    remove_free(bp);
+
+    if (diff >= MINBLKSIZE) {   // 원래 블록의 사이즈와 할당하려는 블록 사이즈의 차이가 블록의 최소크기 보다 커야 분할할 수 있다.
+
+        // 할당 처리
+        PUT(HDRP(bp) , PACK(asize, 1));             // header (asize / 1)
+        PUT(FTRP(bp) , PACK(asize, 1));             // footer (asize / 1)
+        void * leftover_bp = NEXT_BLKP(bp);
+
+        // 남은 부분 가용 처리
+        PUT(HDRP(leftover_bp), PACK(diff, 0));      // header (diff / 0)
+        PUT(FTRP(leftover_bp), PACK(diff, 0));      // footer (diff / 0)
+
+        insert_free(leftover_bp);
+    }
+    else {  // 분할 못하는 경우.
+
+        // 원래 블록을 전부 할당 처리.
+        PUT(FTRP(bp), PACK(original_size, 1));
+        PUT(HDRP(bp), PACK(original_size, 1));
+    }
+}
+
+/*
+ * mm_free - 일단 현재 블록을 free해주고, coalese 를 통해 경우에 따라 인접한 블록들을 연결을 해준다.
+ */
+void mm_free(void *bp)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    PUT(HDRP(bp), PACK(size, 0));       // size 그대로인 free 블록으로 지정.
+    PUT(FTRP(bp), PACK(size, 0));       // size 그대로인 free 블록으로 지정.
+    coalesce(bp);
+}
+
+/*
+ * insert_free - free된 블럭을 (fl, sl) 리스트의 맨 앞에 삽입하고, 비트맵을 켠다.
+*/
+static void insert_free(void *bp)
+{
+    int fl, sl;
+    void *head;
+
+    mapping_insert(GET_SIZE(HDRP(bp)), &fl, &sl);
+    head = ctrl->blocks[fl][sl];
+
+    PUT_LINK(NEXT_FREE(bp), head);
+    PUT(PREV_FREE(bp), 0);
+    if (head)
+        PUT_LINK(PREV_FREE(head), bp);
+    ctrl->blocks[fl][sl] = bp;
+
+    ctrl->fl_bitmap |= 1U << fl;
+    ctrl->sl_bitmap[fl] |= 1U << sl;
+}
+
+/*
+ * remove_free - 가용 블록 bp 를 리스트에서 빼고, 리스트가 비면 비트맵을 끈다.
+*/
+static void remove_free(void *bp)
+{
+    int fl, sl;
+    void *prev = GET_LINK(PREV_FREE(bp));
+    void *next = GET_LINK(NEXT_FREE(bp));
+
+    if (next)
+        PUT_LINK(PREV_FREE(next), prev);
+    if (prev) {
+        PUT_LINK(NEXT_FREE(prev), next);
+        return;
+    }
+
+    // bp 가 리스트의 첫 블록이었다.
+    mapping_insert(GET_SIZE(HDRP(bp)), &fl, &sl);
+    ctrl->blocks[fl][sl] = next;
+    if (!next) {
+        ctrl->sl_bitmap[fl] &= ~(1U << sl);
+        if (!ctrl->sl_bitmap[fl])
+            ctrl->fl_bitmap &= ~(1U << fl);
+    }
+}
+
+/*
+ * coalesce - 인접한 가용 블록과 합친다.
+ *          - 이웃 블록을 리스트에서 빼고, 합쳐진 블록을 새 크기의 리스트에 넣는다.
+ */
+static void *coalesce(void *bp)
+{
+    size_t prev_alloc = GET_ALLOC(bp - DSIZE);              // 앞 블록의 할당 여부  // prologue에는 header가 없어서 이런 방식으로 계산.
+    size_t next_alloc = GET_ALLOC(HDRP(NEXT_BLKP(bp)));     // 뒤 블록의 할당 여부
+    size_t size = GET_SIZE(HDRP(bp));                       // 현재 블록의 사이즈
+
+    /* case 1 : 앞, 뒤 블록 모두 allocated 인 경우. */
+    if (prev_alloc && next_alloc) {
+    }
+    /* case 3 : 앞 블록만 free 인 경우. */
+    else if (next_alloc) {
+        remove_free(PREV_BLKP(bp));
+        size += GET_SIZE(HDRP(PREV_BLKP(bp)));
+        PUT(FTRP(bp), PACK(size, 0));
+        PUT(HDRP(PREV_BLKP(bp)), PACK(size, 0));
+        bp = PREV_BLKP(bp);
+    }
+    /* case 2 : 뒤 블록만 free 인 경우. */
+    else if (prev_alloc) {
+        remove_free(NEXT_BLKP(bp));
+        size += GET_SIZE(HDRP(NEXT_BLKP(bp)));
+        PUT(HDRP(bp), PACK(size, 0));
+        PUT(FTRP(bp), PACK(size, 0));
+    }
+    /* case 4 : 앞, 뒤 블록 모두 free 인 경우. */
+    else {
+        remove_free(PREV_BLKP(bp));
+        remove_free(NEXT_BLKP(bp));
+        size += GET_SIZE(HDRP(PREV_BLKP(bp))) + GET_SIZE(FTRP(NEXT_BLKP(bp)));
+        PUT(HDRP(PREV_BLKP(bp)), PACK(size, 0));
+        PUT(FTRP(NEXT_BLKP(bp)), PACK(size, 0));
+        bp = PREV_BLKP(bp);
+    }
+    insert_free(bp);
+    return bp;
+}
+
+/*
+ * mm_realloc - Implemented simply in terms of mm_malloc and mm_free
+ */
+void *mm_realloc(void *bp, size_t size)
+{
+    void *oldptr = bp;
+    void *newptr;
+    size_t copySize;
+
+    newptr = mm_malloc(size);
+    if (newptr == NULL)
+      return NULL;
+    copySize = GET_SIZE(HDRP(oldptr)) - DSIZE;
+    if (size < copySize)
+      copySize = size;
+    memcpy(newptr, oldptr, copySize);
+
+    mm_free(oldptr);
+    return newptr;
+}
+
+/*
+ * mm_memalign - payload 가 alignment 의 배수에 오는 블록을 준다. alignment 는 2의 거듭제곱이어야 한다.
+ */
+void *mm_memalign(size_t alignment, size_t size)
+{
+    return mm_memalign_offset(alignment, 0, size);
+}
+
+/*
+ * mm_memalign_offset - payload + offset 이 alignment 의 배수에 오는 블록을 준다. offset 은 ALIGNMENT 의 배수이다.
+ *                    - 리스트를 훑지 않고, 앞 조각 (MINBLKSIZE 이상, alignment 미만) 이 생겨도 asize 가 들어가는 크기로 find_fit 한다. (O(1))
+ *                    - 앞 조각은 가용 블록으로 떼어서 자기 리스트에 넣는다. 맞는 블록이 없으면 그 크기만큼 힙을 늘린다.
+ */
+void *mm_memalign_offset(size_t alignment, size_t offset, size_t size)
+{
+    size_t asize, gsize;
+    char *p;
+    void *bp;
+
+    if (size == 0 || (alignment & (alignment - 1)) || offset % ALIGNMENT)
+        return NULL;
+    if (alignment <= ALIGNMENT)
+        return mm_malloc(size);
+
+    if (size <= MINBLKSIZE - DSIZE)
+        asize = MINBLKSIZE;
+    else
+        asize = ALIGN(size) + DSIZE;
+    gsize = asize + alignment + MINBLKSIZE;
+
+    if ((bp = find_fit(gsize)) == NULL && (bp = extend_heap(MAX(gsize, CHUNKSIZE)/WSIZE)) == NULL)
+        return NULL;
+    p = aligned_spot(bp, asize, alignment, offset);
+    place_aligned(bp, p, asize);
+    return p;
+}
+
+/*
+ * aligned_spot - 가용 블록 bp 안에서 asize 블록의 payload + offset 이 alignment 경계에 오는 가장 앞 자리를 돌려준다. 없으면 NULL.
+ *              - 앞에 남는 조각은 없거나 (p == bp) MINBLKSIZE 이상이어야 가용 블록이 될 수 있다.
+ */
+static char *aligned_spot(void *bp, size_t asize, size_t alignment, size_t offset)
+{
+    char *p = (char *)((((size_t)bp + offset + alignment - 1) & ~(alignment - 1)) - offset);
+
+    if (p != (char *)bp && p - (char *)bp < MINBLKSIZE)
+        p += alignment;
+    return p + asize <= (char *)bp + GET_SIZE(HDRP(bp)) ? p : NULL;
+}
+
+/*
+ * place_aligned - 가용 블록 bp 의 p 자리에 asize 블록을 할당한다.
+ *               - 앞 조각은 크기가 줄어서 리스트가 바뀌므로 빼고 다시 넣는다. p 부터는 가용 블록으로 만들어 place 에 맡긴다.
+ */
+static void place_aligned(void *bp, char *p, size_t asize)
+{
+    size_t size = GET_SIZE(HDRP(bp));
+    size_t lead = p - (char *)bp;
+
+    if (lead > 0) {
+        remove_free(bp);
+        PUT(HDRP(bp), PACK(lead, 0));
+        PUT(FTRP(bp), PACK(lead, 0));
+        insert_free(bp);
+        PUT(HDRP(p), PACK(size - lead, 0));
+        PUT(FTRP(p), PACK(size - lead, 0));
+        insert_free(p);
+    }
+    place(p, asize);
+}
+
+/*
+ * mm_free_sized - this engine does not use the size; same as mm_free.
+ */
+void mm_free_sized(void *ptr, size_t size)
+{
+    mm_free(ptr);
+}
+
+/*
+ * mm_usable_size - payload bytes of the block at ptr, at least the size it was requested with.
+ */
+size_t mm_usable_size(void *ptr)
+{
+    return GET_SIZE(HDRP(ptr)) - DSIZE;
+}
+
+/*
+ * mm_malloc_batch - this engine has no batch path; n calls to mm_malloc. Returns how many succeeded.
+ */
+size_t mm_malloc_batch(size_t size, size_t n, void **out)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if ((out[i] = mm_malloc(size)) == NULL)
+            break;
+    return i;
+}
+
+/*
+ * mm_free_batch - this engine has no batch path; n calls to mm_free.
+ */
+void mm_free_batch(void **ptrs, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        mm_free(ptrs[i]);
+}
+
+/*
+ * mm_set_place - this engine has one placement; the rule is ignored.
+ */
+void mm_set_place(size_t size, int end)
+{
+}
+
+/*
+ * mm_set_fit - this engine has one fit policy; the policy is ignored.
+ */
+void mm_set_fit(int policy)
+{
+}
+
+/*
+ * mm_malloc_flags - this engine takes no placement hints; mm_malloc, with the payload cleared for MALLOC_ZERO.
+ */
+void *mm_malloc_flags(size_t size, int flags, void *near)
+{
+    void *p = mm_malloc(size);
+
+    if (p != NULL && (flags & MALLOC_ZERO))
+        memset(p, 0, size);
+    return p;
+}
+
+/*
+ * mm_report - this engine keeps no counters.
+ */
+void mm_report(void)
+{
+}
+
+/*
+ * mm_checkheap - check heap invariants for this implementation.
+ *
+ * #ifdef DEBUG
+ *   CHECKHEAP();
+ * #endif
+*/
+void mm_checkheap(int lineno)
+{
+    char *heap_lo = mem_heap_lo();                      // pointing first word of the heap
+    char *heap_hi = heap_lo + (mem_heapsize()-WSIZE);   // pointing last word of the heap
+    char *bp;
+    int fl, sl;
+    int heap_free_cnt = 0;
+    int list_free_cnt = 0;
+
+    /* heap level check*/
+    assert((char *)ctrl == heap_lo);
+    assert(GET(heap_lo + CTRLSIZE) == PACK(WSIZE,1));  // check PROLOGUE footer
+    assert(GET(heap_hi) == PACK(0,1));                  // check epilogue block
+
+    /* block level */
+    // prologue footer (4/1) 의 크기는 GET_SIZE 로 읽으면 0 이므로, 첫 번째 블록부터 순회한다.
+    for(bp = heap_listp + WSIZE ; GET_SIZE(HDRP(bp)) > 0 ; bp = NEXT_BLKP(bp)) {
+        assert(GET(HDRP(bp)) == GET(FTRP(bp)));     // check header and footer match
+        assert(!(UINT_CAST(bp) & 0x7));             // check if payload area aligned
+        assert(GET_ALLOC(HDRP(bp)) | GET_ALLOC(HDRP(NEXT_BLKP(bp))));   // check contiguous free blocks
+        assert(heap_lo < HDRP(bp) && FTRP(bp) < heap_hi);               // check heap bound
+
+        // check all free blocks are in the list of their own (fl, sl)
+        if (!GET_ALLOC(HDRP(bp))) {
+            void *next_free;
+            mapping_insert(GET_SIZE(HDRP(bp)), &fl, &sl);
+            for (next_free = ctrl->blocks[fl][sl]; next_free != NULL; next_free = GET_LINK(NEXT_FREE(next_free))) {
+                if (next_free == bp)
+                    break;
+            }
+            assert(next_free);
+            heap_free_cnt++;
+        }
+    }
+
+    /* list level check */
+    for (fl = 0; fl < FL_COUNT; fl++) {
+        // fl_bitmap 비트는 sl_bitmap[fl] 이 비어있지 않을 때만 켜져 있어야 한다.
+        assert(!(ctrl->fl_bitmap & (1U << fl)) == !ctrl->sl_bitmap[fl]);
+        for (sl = 0; sl < SL_COUNT; sl++) {
+            void *prev_free = NULL;
+            void *next_free = ctrl->blocks[fl][sl];
+            int f, s;
+
+            // sl_bitmap 비트는 리스트가 비어있지 않을 때만 켜져 있어야 한다.
+            assert(!(ctrl->sl_bitmap[fl] & (1U << sl)) == !next_free);
+            while (next_free != NULL) {
+                assert(!GET_ALLOC(HDRP(next_free)));
+                mapping_insert(GET_SIZE(HDRP(next_free)), &f, &s);
+                assert(f == fl && s == sl);                                 // check block is in the right list
+                assert(GET_LINK(PREV_FREE(next_free)) == prev_free);     // check back link
+                assert(++list_free_cnt <= heap_free_cnt);                   // detect cycle
+
+                prev_free = next_free;
+                next_free = GET_LINK(NEXT_FREE(next_free));
+            }
+        }
+    }
+    assert(heap_free_cnt == list_free_cnt);     // no stale block left in any list
+}
@@ -2,8 +2,32 @@
 
 extern int mm_init (void);
 extern void *mm_malloc (size_t size);
+extern void *mm_malloc_flags(size_t size, int flags, void *near);
 extern void mm_free (void *ptr);
+extern void mm_free_sized(void *ptr, size_t size);
+extern size_t mm_usable_size(void *ptr);
 extern void *mm_realloc(void *ptr, size_t size);
+extern void *mm_memalign(size_t alignment, size_t size);
+extern void *mm_memalign_offset(size_t alignment, size_t offset, size_t size);
+extern size_t mm_malloc_batch(size_t size, size_t n, void **out);
+extern void mm_free_batch(void **ptrs, size_t n);       /* ptrs 배열의 순서를 바꿀 수 있다 (explicit 은 주소 순으로 정렬한다) */
+extern void mm_set_place(size_t size, int end);
+extern void mm_set_fit(int policy);
+extern void mm_report(void);
+
+/* mm_set_place 의 end : 가용 블록의 어느 쪽에서 자를지 */
+#define PLACE_LOW   0
+#define PLACE_HIGH  1
+
+/* mm_set_fit 의 policy : 가용 블록을 어디서부터 찾을지 */
+#define FIT_FIRST   0
+#define FIT_NEXT    1
+
+/* mm_malloc_flags 의 flags : 호출자가 블록에 대해 아는 것. | 로 묶는다. */
+#define MALLOC_SHORT    0x1     /* 곧 free 한다 */
+#define MALLOC_LONG     0x2     /* 오래 살아 있는다 */
+#define MALLOC_ZERO     0x4     /* payload 를 0 으로 채워서 준다 (calloc) */
+#define MALLOC_NEAR     0x8     /* near 블록과 같은 cache line 이나 page 에 두면 좋다 */
 
 
 /* 
@@ -0,0 +1,259 @@
+/*
+ * mtstress.c - multi-threaded stress test for the mm package
+ *
+ * mdriver 는 한 스레드로 trace 를 돌리므로 lock 이나 arena 배정이 틀려도 드러나지 않는다.
+ * mtstress 는 여러 스레드가 동시에 할당하고, 할당한 블록의 절반쯤을 이웃 스레드의 mailbox 로 넘긴다.
+ * 이웃 스레드는 mailbox 에서 꺼낸 블록의 내용이 그대로인지 확인한 뒤 free 한다. (cross-thread free)
+ * 블록마다 주인 스레드와 순번으로 만든 byte 를 채우므로, 두 스레드가 같은 블록을 받거나
+ * 누가 free 한 블록을 덮어쓰면 내용이 달라져서 잡힌다.
+ *
+ * 스레드 안전한 엔진은 mm-arena.c 뿐이다. 다른 엔진은 -c 로 tcache (tc_lock 으로 감싼다) 를 통해 돌린다.
+ *   make IMPL=arena mtstress && ./mtstress
+ *   make IMPL=explicit mtstress && ./mtstress -c
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <unistd.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "mm.h"
+#include "tcache.h"
+#include "memlib.h"
+
+/* Misc */
+#define MAX_THREADS  16
+#define MAILBOX_SIZE 256        /* blocks a thread may have waiting for it */
+#define MAX_LIVE     64         /* blocks a thread keeps for itself */
+#define MAX_REQUEST  2048       /* largest request (bytes) */
+
+/* Fill byte of the block a thread made as its i-th request */
+#define FILL(tid, i) ((unsigned char)((tid) * 31 + (i)))
+
+/* a block, with what it was filled with */
+typedef struct {
+    unsigned char *p;
+    size_t size;
+    unsigned char fill;
+} block_t;
+
+/* blocks other threads handed to one thread for freeing */
+typedef struct {
+    pthread_mutex_t lock;
+    block_t blocks[MAILBOX_SIZE];
+    int count;
+} mailbox_t;
+
+/* per-thread arguments */
+typedef struct {
+    int tid;
+    pthread_t thread;
+    int errors;
+} worker_t;
+
+/* Global variables */
+static int num_threads = 4;
+static int num_ops = 100000;
+static mailbox_t mailboxes[MAX_THREADS];
+
+/* The package under test, switched to the tcache by -c */
+static int (*init_fn)(void) = mm_init;
+static void *(*malloc_fn)(size_t size) = mm_malloc;
+static void (*free_fn)(void *ptr) = mm_free;
+static void *(*realloc_fn)(void *ptr, size_t size) = mm_realloc;
+static void *(*memalign_fn)(size_t alignment, size_t size) = mm_memalign;
+
+/* Function prototypes */
+static void *worker(void *arg);
+static int check_block(block_t *b, int tid);
+static void fill_block(block_t *b);
+static void usage(void);
+
+int main(int argc, char **argv)
+{
+    worker_t workers[MAX_THREADS];
+    int c, i, j, errors = 0;
+
+    while ((c = getopt(argc, argv, "ct:n:h")) != EOF) {
+        switch (c) {
+        case 'c':
+            init_fn = tc_init;
+            malloc_fn = tc_malloc;
+            free_fn = tc_free;
+            realloc_fn = tc_realloc;
+            memalign_fn = tc_memalign;
+            break;
+        case 't':
+            num_threads = atoi(optarg);
+            if (num_threads < 1 || num_threads > MAX_THREADS) {
+                fprintf(stderr, "Error: -t must be 1 .. %d\n", MAX_THREADS);
+                exit(1);
+            }
+            break;
+        case 'n':
+            num_ops = atoi(optarg);
+            break;
+        case 'h':
+            usage();
+            exit(0);
+        default:
+            usage();
+            exit(1);
+        }
+    }
+
+    mem_init();
+    if (init_fn() < 0) {
+        fprintf(stderr, "Error: mm_init failed\n");
+        exit(1);
+    }
+    for (i = 0; i < num_threads; i++) {
+        pthread_mutex_init(&mailboxes[i].lock, NULL);
+        mailboxes[i].count = 0;
+    }
+
+    for (i = 0; i < num_threads; i++) {
+        workers[i].tid = i;
+        workers[i].errors = 0;
+        if (pthread_create(&workers[i].thread, NULL, worker, &workers[i]) != 0) {
+            fprintf(stderr, "Error: pthread_create failed\n");
+            exit(1);
+        }
+    }
+    for (i = 0; i < num_threads; i++) {
+        pthread_join(workers[i].thread, NULL);
+        errors += workers[i].errors;
+    }
+
+    /* Blocks handed over after their receiver finished are freed here */
+    for (i = 0; i < num_threads; i++)
+        for (j = 0; j < mailboxes[i].count; j++) {
+            errors += check_block(&mailboxes[i].blocks[j], -1);
+            free_fn(mailboxes[i].blocks[j].p);
+        }
+
+    mem_deinit();
+    if (errors) {
+        printf("mtstress: %d threads, %d ops each: %d errors\n", num_threads, num_ops, errors);
+        exit(1);
+    }
+    printf("mtstress: %d threads, %d ops each: OK\n", num_threads, num_ops);
+    exit(0);
+}
+
+/*
+ * worker - 블록을 할당해서 채우고, 일부는 직접 free 하거나 realloc 하고, 일부는 다음 스레드의 mailbox 로 넘긴다.
+ *          매 요청마다 자기 mailbox 에 온 블록들을 확인하고 free 한다.
+ */
+static void *worker(void *arg)
+{
+    worker_t *w = (worker_t *)arg;
+    mailbox_t *mine = &mailboxes[w->tid];
+    mailbox_t *next = &mailboxes[(w->tid + 1) % num_threads];
+    block_t live[MAX_LIVE], inbox[MAILBOX_SIZE];
+    int num_live = 0, num_inbox, i, k;
+    unsigned int seed = w->tid + 1;
+    block_t b;
+
+    for (i = 0; i < num_ops; i++) {
+        /* free what the other threads handed over */
+        pthread_mutex_lock(&mine->lock);
+        num_inbox = mine->count;
+        memcpy(inbox, mine->blocks, num_inbox * sizeof(block_t));
+        mine->count = 0;
+        pthread_mutex_unlock(&mine->lock);
+        for (k = 0; k < num_inbox; k++) {
+            w->errors += check_block(&inbox[k], w->tid);
+            free_fn(inbox[k].p);
+        }
+
+        b.size = rand_r(&seed) % MAX_REQUEST + 1;
+        b.fill = FILL(w->tid, i);
+        if (i % 16 == 0)
+            b.p = memalign_fn(64, b.size);
+        else
+            b.p = malloc_fn(b.size);
+        if (b.p == NULL) {
+            fprintf(stderr, "thread %d: allocation of %u bytes failed\n", w->tid, (unsigned int)b.size);
+            w->errors++;
+            break;
+        }
+        fill_block(&b);
+
+        /* hand it to the next thread, or keep it */
+        if (rand_r(&seed) % 2 && num_threads > 1) {
+            pthread_mutex_lock(&next->lock);
+            if (next->count < MAILBOX_SIZE) {
+                next->blocks[next->count++] = b;
+                b.p = NULL;
+            }
+            pthread_mutex_unlock(&next->lock);
+            if (b.p == NULL)
+                continue;
+        }
+        if (num_live == MAX_LIVE) {
+            k = rand_r(&seed) % MAX_LIVE;
+            w->errors += check_block(&live[k], w->tid);
+            if (rand_r(&seed) % 4 == 0) {       // grow or shrink one in place of freeing it
+                size_t size = rand_r(&seed) % MAX_REQUEST + 1;
+                unsigned char *p = realloc_fn(live[k].p, size);
+
+                if (p == NULL) {
+                    w->errors++;
+                    break;
+                }
+                live[k].p = p;
+                live[k].size = size;
+                fill_block(&live[k]);
+                k = (k + 1) % MAX_LIVE;
+                w->errors += check_block(&live[k], w->tid);
+            }
+            free_fn(live[k].p);
+            live[k] = live[--num_live];
+        }
+        live[num_live++] = b;
+    }
+
+    for (k = 0; k < num_live; k++) {
+        w->errors += check_block(&live[k], w->tid);
+        free_fn(live[k].p);
+    }
+    return NULL;
+}
+
+/*
+ * check_block - 블록 내용이 채운 그대로인지 본다. 틀리면 1 을 돌려준다.
+ */
+static int check_block(block_t *b, int tid)
+{
+    size_t i;
+
+    for (i = 0; i < b->size; i++)
+        if (b->p[i] != b->fill) {
+            fprintf(stderr, "thread %d: block %p (%u bytes) changed at byte %u\n",
+                    tid, (void *)b->p, (unsigned int)b->size, (unsigned int)i);
+            return 1;
+        }
+    return 0;
+}
+
+/*
+ * fill_block - 블록을 b->fill 로 채운다.
+ */
+static void fill_block(block_t *b)
+{
+    memset(b->p, b->fill, b->size);
+}
+
+/*
+ * usage - Explain the command line arguments
+ */
+static void usage(void)
+{
+    fprintf(stderr, "Usage: mtstress [-ch] [-t <threads>] [-n <ops>]\n");
+    fprintf(stderr, "Options\n");
+    fprintf(stderr, "\t-c         Run through the thread-local cache (tc_*).\n");
+    fprintf(stderr, "\t-h         Print this message.\n");
+    fprintf(stderr, "\t-n <ops>   Requests per thread (default 100000).\n");
+    fprintf(stderr, "\t-t <n>     Number of threads (default 4, at most 16).\n");
+}
@@ -0,0 +1,435 @@
+/*
+ * tcache.c - thread-local cache front end over the mm package.
+ *
+ * mm 패키지의 전역 변수(heap_listp, root ...) 는 스레드 안전하지 않으므로 모든 mm_* 호출은 tc_lock 으로 감싼다.
+ * 매번 lock 을 잡지 않도록, 각 스레드는 크기 클래스별 bin 을 가진다.
+ *  - bin c 는 payload 가 (c+1) * TC_STEP 바이트인 블록들의 단일 연결 리스트이다. (16, 32, ... 256 bytes)
+ *  - tc_malloc 은 bin 에서 꺼내고, 비어 있으면 lock 을 한 번 잡고 TC_BATCH 개를 mm_malloc 해서 채운다.
+ *  - tc_free 는 bin 에 넣고, bin 이 TC_BIN_MAX 개를 넘거나 스레드의 캐시 용량이 tc_cap 을 넘으면
+ *    lock 을 한 번 잡고 bin 의 절반을 mm_free 한다.
+ *  - 더 큰 요청은 lock 을 잡고 mm 패키지로 바로 보낸다.
+ *
+ * tc_free 가 블록의 크기 클래스를 알 수 있도록, 모든 블록 앞에 TC_HDR 바이트의 숨은 header 를 두고 클래스 번호를 적는다.
+ * (mm 패키지의 블록 header 는 엔진마다 모양이 달라서 읽을 수 없다.)
+ *
+ *   mm_malloc 이 준 포인터
+ *   v
+ *   +-----------+--------------------------------+
+ *   |  class    |  user payload                  |
+ *   +-----------+--------------------------------+
+ *               ^
+ *               tc_malloc 이 돌려주는 포인터 (bin 안에 있을 때는 여기에 next 포인터를 적는다)
+ *
+ * tc_memalign 블록은 mm_memalign_offset 으로 payload 가 alignment 경계보다 2 * TC_HDR 앞에 오는 블록을 받는다.
+ * 그 2 * TC_HDR 에 숨은 header 와 함께 mm 포인터까지의 거리(offset) 와 요청 크기를 적어 둔다.
+ * 경계 앞의 남는 공간은 엔진이 가용 블록으로 떼어 두므로, 블록마다 alignment 만큼 낭비하지 않는다.
+ *
+ *   mm_memalign_offset 이 준 포인터
+ *   v
+ *   +--------+--------+-----------+-----------------------+
+ *   | offset |  size  |  class    |  user payload         |
+ *   +--------+--------+-----------+-----------------------+
+ *                                 ^
+ *                                 tc_memalign 이 돌려주는 포인터 (alignment 경계)
+ *
+ * mm_init 은 힙을 통째로 비우므로, tc_init 은 tc_epoch 을 올려서 모든 스레드의 bin 을 무효로 만든다.
+ * 각 스레드는 다음 호출에서 epoch 이 바뀐 것을 보고 bin 을 (mm_free 하지 않고) 버린다.
+ * tc_init 은 다른 스레드가 캐시를 쓰고 있지 않을 때만 불러야 한다.
+ */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <pthread.h>
+
+#include "tcache.h"
+#include "mm.h"
+
+#ifndef ALIGNMENT
+#define ALIGNMENT       8
+#endif
+#define TC_HDR          ALIGNMENT           /* hidden header size, keeps the payload ALIGNMENT-byte aligned */
+#define TC_STEP         16                  /* payload size step between bins */
+#define TC_NBINS        16                  /* bins cover payloads up to TC_NBINS * TC_STEP (256) bytes */
+#define TC_MAXSIZE      (TC_NBINS * TC_STEP)
+#define TC_LARGE        TC_NBINS            /* class of blocks that bypass the bins */
+#define TC_ALIGNED      (TC_NBINS + 1)      /* class of tc_memalign blocks, which also bypass the bins */
+#define TC_BATCH        8                   /* blocks moved per refill / flush */
+#define TC_BIN_MAX      (4 * TC_BATCH)      /* most blocks one bin may hold */
+#define TC_DEFAULT_CAP  (32 * 1024)         /* default per-thread cache size (bytes) */
+
+/* size class of a request, and payload bytes of a class */
+#define TC_CLASS(size)      ((size) <= TC_STEP ? 0 : ((size) - 1) / TC_STEP)
+#define TC_CLASS_SIZE(c)    (((c) + 1) * TC_STEP)
+
+/* hidden header and bin link of a user pointer */
+#define TC_BASE(p)      ((char *)(p) - TC_HDR)
+#define TC_USER(base)   ((char *)(base) + TC_HDR)
+#define TC_CLASSOF(p)   (*(unsigned int *)TC_BASE(p))
+#define TC_NEXT(p)      (*(void **)(p))
+
+/* extra words of a TC_ALIGNED block, below its hidden header */
+#define TC_OFFSET(p)    (*(unsigned int *)(TC_BASE(p) - TC_HDR))
+#define TC_SIZE(p)      (*(unsigned int *)(TC_BASE(p) - TC_HDR + sizeof(unsigned int)))
+
+typedef struct {
+    void *head[TC_NBINS];   /* LIFO bin of cached user pointers per class */
+    int count[TC_NBINS];    /* blocks in each bin */
+    size_t bytes;           /* payload bytes held over all bins */
+    unsigned int epoch;     /* tc_epoch the bins belong to */
+    int registered;         /* thread exit destructor is armed */
+    int hits, refills, flushes;
+} tcache_t;
+
+/* shared state */
+static pthread_mutex_t tc_lock = PTHREAD_MUTEX_INITIALIZER;    /* guards every mm_* call */
+static pthread_key_t tc_key;                                    /* flushes a thread's bins when it exits */
+static pthread_once_t tc_key_once = PTHREAD_ONCE_INIT;
+static unsigned int tc_epoch;
+static size_t tc_cap = TC_DEFAULT_CAP;
+
+/* per-thread state */
+static __thread tcache_t tc;
+
+static void *backend_malloc(size_t size, unsigned int class);
+static void refill(unsigned int class);
+static void flush_bin(unsigned int class, int keep);
+static void check_epoch(void);
+static void make_key(void);
+static void thread_exit(void *arg);
+
+/*
+ * tc_init - mm_init 으로 힙을 초기화하고, 모든 스레드의 bin 을 무효로 만든다.
+ */
+int tc_init(void)
+{
+    int ret;
+
+    pthread_once(&tc_key_once, make_key);
+    pthread_mutex_lock(&tc_lock);
+    ret = mm_init();
+    tc_epoch++;
+    pthread_mutex_unlock(&tc_lock);
+    check_epoch();
+    return ret;
+}
+
+/*
+ * tc_malloc - 작은 요청은 bin 에서, 큰 요청은 mm_malloc 에서 가져온다.
+ */
+void *tc_malloc(size_t size)
+{
+    unsigned int class;
+    void *p;
+
+    if (size > TC_MAXSIZE) {
+        pthread_mutex_lock(&tc_lock);
+        p = backend_malloc(size, TC_LARGE);
+        pthread_mutex_unlock(&tc_lock);
+        return p;
+    }
+
+    check_epoch();
+    class = TC_CLASS(size);
+    if (tc.head[class] == NULL)
+        refill(class);
+    else
+        tc.hits++;
+    if ((p = tc.head[class]) == NULL)       // 힙이 모자라서 하나도 못 채웠다.
+        return NULL;
+    tc.head[class] = TC_NEXT(p);
+    tc.count[class]--;
+    tc.bytes -= TC_CLASS_SIZE(class);
+    return p;
+}
+
+/*
+ * tc_malloc_flags - 큰 요청은 flags 를 그대로 mm_malloc_flags 에 넘긴다. near 는 그 블록의 mm 포인터로 바꿔서 넘긴다.
+ *                 - 작은 요청은 bin 에서 주므로 놓일 자리는 고를 수 없고, MALLOC_ZERO 만 지킨다.
+ */
+void *tc_malloc_flags(size_t size, int flags, void *near)
+{
+    char *base;
+    void *p;
+
+    if (size <= TC_MAXSIZE) {
+        if ((p = tc_malloc(size)) != NULL && (flags & MALLOC_ZERO))
+            memset(p, 0, size);
+        return p;
+    }
+    if (near != NULL)
+        near = TC_CLASSOF(near) == TC_ALIGNED ? (char *)near - TC_OFFSET(near) : TC_BASE(near);
+
+    pthread_mutex_lock(&tc_lock);
+    base = mm_malloc_flags(size + TC_HDR, flags, near);
+    pthread_mutex_unlock(&tc_lock);
+    if (base == NULL)
+        return NULL;
+    *(unsigned int *)base = TC_LARGE;
+    return TC_USER(base);
+}
+
+/*
+ * tc_free - 작은 블록은 bin 에 넣고, bin 이나 캐시 용량이 넘치면 절반을 mm_free 한다.
+ */
+void tc_free(void *ptr)
+{
+    unsigned int class;
+
+    if (ptr == NULL)
+        return;
+
+    class = TC_CLASSOF(ptr);
+    if (class == TC_LARGE || class == TC_ALIGNED) {
+        pthread_mutex_lock(&tc_lock);
+        mm_free(class == TC_LARGE ? TC_BASE(ptr) : (char *)ptr - TC_OFFSET(ptr));
+        pthread_mutex_unlock(&tc_lock);
+        return;
+    }
+
+    check_epoch();
+    if (tc.count[class] >= TC_BIN_MAX || tc.bytes + TC_CLASS_SIZE(class) > tc_cap)
+        flush_bin(class, tc.count[class] / 2);
+    if (tc.bytes + TC_CLASS_SIZE(class) > tc_cap) {     // 이 bin 을 비워도 모자라면 (tc_cap 이 아주 작으면) 바로 돌려준다.
+        pthread_mutex_lock(&tc_lock);
+        mm_free(TC_BASE(ptr));
+        pthread_mutex_unlock(&tc_lock);
+        return;
+    }
+    TC_NEXT(ptr) = tc.head[class];
+    tc.head[class] = ptr;
+    tc.count[class]++;
+    tc.bytes += TC_CLASS_SIZE(class);
+}
+
+/*
+ * tc_free_sized - 크기 클래스는 숨은 header 에 있으므로 size 는 쓰지 않는다. tc_free 와 같다.
+ */
+void tc_free_sized(void *ptr, size_t size)
+{
+    tc_free(ptr);
+}
+
+/*
+ * tc_usable_size - 작은 블록은 클래스 크기, 큰 블록은 mm 블록에서 숨은 header 를 뺀 만큼, tc_memalign 블록은 요청 크기.
+ */
+size_t tc_usable_size(void *ptr)
+{
+    unsigned int class = TC_CLASSOF(ptr);
+    size_t size;
+
+    if (class == TC_ALIGNED)
+        return TC_SIZE(ptr);
+    if (class != TC_LARGE)
+        return TC_CLASS_SIZE(class);
+    pthread_mutex_lock(&tc_lock);
+    size = mm_usable_size(TC_BASE(ptr)) - TC_HDR;
+    pthread_mutex_unlock(&tc_lock);
+    return size;
+}
+
+/*
+ * tc_malloc_batch - tc_malloc 을 n 번 부른다. 작은 블록은 bin 이 이미 mm 패키지에서 한꺼번에 채워 온다.
+ */
+size_t tc_malloc_batch(size_t size, size_t n, void **out)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        if ((out[i] = tc_malloc(size)) == NULL)
+            break;
+    return i;
+}
+
+/*
+ * tc_free_batch - tc_free 를 n 번 부른다. bin 이 넘치면 flush_bin 이 한꺼번에 돌려준다.
+ */
+void tc_free_batch(void **ptrs, size_t n)
+{
+    size_t i;
+
+    for (i = 0; i < n; i++)
+        tc_free(ptrs[i]);
+}
+
+/*
+ * tc_realloc - 큰 블록은 mm_realloc 에 맡기고, 작은 블록은 클래스 안에 들어가면 그대로, 아니면 옮긴다.
+ */
+void *tc_realloc(void *ptr, size_t size)
+{
+    unsigned int class;
+    size_t copySize;
+    void *newptr;
+
+    if (ptr == NULL)
+        return tc_malloc(size);
+    if (size == 0) {
+        tc_free(ptr);
+        return NULL;
+    }
+
+    class = TC_CLASSOF(ptr);
+    if (class == TC_LARGE) {
+        pthread_mutex_lock(&tc_lock);
+        newptr = mm_realloc(TC_BASE(ptr), size + TC_HDR);   // 숨은 header 도 같이 옮겨진다.
+        pthread_mutex_unlock(&tc_lock);
+        return newptr == NULL ? NULL : TC_USER(newptr);
+    }
+
+    copySize = class == TC_ALIGNED ? TC_SIZE(ptr) : TC_CLASS_SIZE(class);
+    if (size <= copySize)
+        return ptr;
+    if ((newptr = tc_malloc(size)) == NULL)
+        return NULL;
+    memcpy(newptr, ptr, copySize);
+    tc_free(ptr);
+    return newptr;
+}
+
+/*
+ * tc_memalign - alignment 가 TC_HDR 이하면 tc_malloc 과 같고, 아니면 lock 을 잡고 mm_memalign_offset 으로 바로 보낸다.
+ *             - tc_realloc 은 이 블록을 늘릴 때 새 tc_malloc 블록으로 옮긴다. (alignment 는 유지되지 않는다.)
+ */
+void *tc_memalign(size_t alignment, size_t size)
+{
+    char *base, *p;
+
+    if (alignment <= TC_HDR)
+        return tc_malloc(size);
+
+    pthread_mutex_lock(&tc_lock);
+    base = mm_memalign_offset(alignment, 2 * TC_HDR, size + 2 * TC_HDR);
+    pthread_mutex_unlock(&tc_lock);
+    if (base == NULL)
+        return NULL;
+    p = base + 2 * TC_HDR;
+    TC_CLASSOF(p) = TC_ALIGNED;
+    TC_OFFSET(p) = 2 * TC_HDR;
+    TC_SIZE(p) = size;
+    return p;
+}
+
+/*
+ * tc_set_cap - 스레드 하나가 bin 에 쥐고 있을 수 있는 payload 바이트 수를 정한다. 0 이면 캐시를 쓰지 않는 것과 같다.
+ *            - 이미 넘친 스레드는 다음 tc_free 때 줄어든다.
+ */
+void tc_set_cap(size_t bytes)
+{
+    tc_cap = bytes;
+}
+
+/*
+ * tc_flush - 호출한 스레드의 bin 을 모두 mm_free 한다.
+ */
+void tc_flush(void)
+{
+    unsigned int class;
+
+    check_epoch();
+    for (class = 0; class < TC_NBINS; class++)
+        flush_bin(class, 0);
+}
+
+/*
+ * tc_report - print the calling thread's cache counters since tc_init.
+ */
+void tc_report(void)
+{
+    printf("tcache: %d hits, %d refills, %d flushes, %u bytes cached (cap %u)\n",
+           tc.hits, tc.refills, tc.flushes, (unsigned int)tc.bytes, (unsigned int)tc_cap);
+}
+
+/*
+ * backend_malloc - mm_malloc 으로 숨은 header 를 포함한 블록을 받아 class 를 적는다. tc_lock 을 잡은 채로 부른다.
+ */
+static void *backend_malloc(size_t size, unsigned int class)
+{
+    char *base;
+
+    if ((base = mm_malloc(size + TC_HDR)) == NULL)
+        return NULL;
+    *(unsigned int *)base = class;
+    return TC_USER(base);
+}
+
+/*
+ * refill - 빈 bin 을 lock 한 번에 TC_BATCH 개까지 채운다. 캐시 용량이 모자라면 하나만 채운다.
+ */
+static void refill(unsigned int class)
+{
+    size_t csize = TC_CLASS_SIZE(class);
+    int n = TC_BATCH;
+    void *p;
+
+    if (tc.bytes + n * csize > tc_cap)
+        n = tc_cap > tc.bytes ? (tc_cap - tc.bytes) / csize : 0;
+    if (n < 1)
+        n = 1;              // 돌려줄 블록 하나는 용량과 상관없이 가져온다.
+
+    if (!tc.registered) {   // 이 스레드가 처음 힙에 오면 종료 시 bin 을 비우도록 등록한다.
+        pthread_once(&tc_key_once, make_key);
+        pthread_setspecific(tc_key, &tc);
+        tc.registered = 1;
+    }
+
+    tc.refills++;
+    pthread_mutex_lock(&tc_lock);
+    while (n-- > 0) {
+        if ((p = backend_malloc(csize, class)) == NULL)
+            break;
+        TC_NEXT(p) = tc.head[class];
+        tc.head[class] = p;
+        tc.count[class]++;
+        tc.bytes += csize;
+    }
+    pthread_mutex_unlock(&tc_lock);
+}
+
+/*
+ * flush_bin - bin 의 블록을 keep 개만 남기고 lock 한 번에 mm_free 한다.
+ */
+static void flush_bin(unsigned int class, int keep)
+{
+    void *p;
+
+    if (tc.count[class] <= keep)
+        return;
+
+    tc.flushes++;
+    pthread_mutex_lock(&tc_lock);
+    while (tc.count[class] > keep) {
+        p = tc.head[class];
+        tc.head[class] = TC_NEXT(p);
+        tc.count[class]--;
+        tc.bytes -= TC_CLASS_SIZE(class);
+        mm_free(TC_BASE(p));
+    }
+    pthread_mutex_unlock(&tc_lock);
+}
+
+/*
+ * check_epoch - tc_init 이후 처음 불리면, 이전 힙에 속한 bin 을 mm_free 없이 버린다.
+ */
+static void check_epoch(void)
+{
+    if (tc.epoch == tc_epoch)
+        return;
+    memset(tc.head, 0, sizeof(tc.head));
+    memset(tc.count, 0, sizeof(tc.count));
+    tc.bytes = 0;
+    tc.hits = tc.refills = tc.flushes = 0;
+    tc.epoch = tc_epoch;
+}
+
+static void make_key(void)
+{
+    pthread_key_create(&tc_key, thread_exit);
+}
+
+/*
+ * thread_exit - 스레드가 끝날 때 bin 에 남은 블록을 힙으로 돌려준다.
+ */
+static void thread_exit(void *arg)
+{
+    (void)arg;
+    tc_flush();
+}
@@ -0,0 +1,22 @@
+/*
+ * tcache.h - thread-local cache front end over the mm package.
+ *
+ * tc_malloc / tc_free / tc_realloc 는 mm_malloc / mm_free / mm_realloc 와 같은 일을 하지만,
+ * 작은 요청은 스레드마다 가진 크기 클래스별 bin 에서 lock 없이 처리하고,
+ * bin 이 비거나 넘칠 때만 공유 힙(mm 패키지)을 lock 으로 잡고 한꺼번에 채우거나 비운다.
+ */
+#include <stdio.h>
+
+extern int tc_init(void);
+extern void *tc_malloc(size_t size);
+extern void *tc_malloc_flags(size_t size, int flags, void *near);
+extern void tc_free(void *ptr);
+extern void tc_free_sized(void *ptr, size_t size);
+extern size_t tc_usable_size(void *ptr);
+extern void *tc_realloc(void *ptr, size_t size);
+extern void *tc_memalign(size_t alignment, size_t size);
+extern size_t tc_malloc_batch(size_t size, size_t n, void **out);
+extern void tc_free_batch(void **ptrs, size_t n);
+extern void tc_set_cap(size_t bytes);
+extern void tc_flush(void);
+extern void tc_report(void);
@@ -81,6 +81,26 @@ while ($line = <STDIN>) {
     # save the line for output later
     $lines[$requestnum++] = $line;
 
+    # batch requests are checked like one request per id in the batch
+    if ($cmd eq "A" or $cmd eq "F") {
+	$count = $size;
+	for ($i = $id; $i < $id + $count; $i++) {
+	    if ($cmd eq "A" and exists($HASH{$i})) {
+		die "$0: ERROR[$linenum]: batch allocate reuses ID $i.\n";
+	    }
+	    if ($cmd eq "F" and $HASH{$i} ne "a" and $HASH{$i} ne "r") {
+		die "$0: ERROR[$linenum]: batch free of unallocated block $i.\n";
+	    }
+	    if ($cmd eq "A") {
+		$HASH{$i} = "a";
+	    }
+	    else {
+		delete $HASH{$i};
+	    }
+	}
+	next;
+    }
+
     #ignore realloc requests, as long as they are preceeded by an alloc request
     if ($cmd eq "r") {
 	if (!$HASH{$id}) {
@@ -89,11 +109,26 @@ while ($line = <STDIN>) {
 	next;
     }
 
+    # hinted allocate requests are checked like allocate requests,
+    # and a near hint must name a block that is still allocated
+    if ($cmd eq "h") {
+	($cmd, $id, $flags, $near) = split(" ", $line);
+	if ($flags =~ /n/ and $HASH{$near} ne "a" and $HASH{$near} ne "r") {
+	    die "$0: ERROR[$linenum]: near hint names unallocated block $near.\n";
+	}
+	$cmd = "m";
+    }
+
+    # memalign requests are checked like allocate requests
+    if ($cmd eq "m" and $HASH{$id} eq "a") {
+	die "$0: ERROR[$linenum]: memalign with no intervening free.\n";
+    }
+
     if ($cmd eq "a" and $HASH{$id} eq "a") {
 	die "$0: ERROR[$linenum]: allocate with no intervening free.\n";
     }
 
-    if ($cmd eq "a" and $HASH{$id} eq "f") {
+    if (($cmd eq "a" or $cmd eq "m") and $HASH{$id} eq "f") {
 	die "$0: ERROR[$linenum]: reused ID $id.\n";
     }
 
@@ -110,6 +145,9 @@ while ($line = <STDIN>) {
     if ($cmd eq "f") {
 	delete $HASH{$id};
     }
+    elsif ($cmd eq "m") {
+	$HASH{$id} = "a";
+    }
     else {
 	$HASH{$id} = $cmd;
     }
@@ -0,0 +1,80 @@
+#!/usr/bin/perl
+#!/usr/local/bin/perl
+
+$out_filename = $argv[0];
+$out_filename = "batch.rep" unless $out_filename;
+$num_handlers = $argv[1];
+$num_handlers = 600 unless $num_handlers;
+$max_live = 8;
+
+# Create trace
+# Each request handler allocates 16 to 64 same-size nodes at once
+# (a batch) and one buffer of its own, and later releases them.
+# Up to $max_live handlers are in flight; a random one retires when
+# a new one would exceed that. Three out of four retire their nodes
+# with one batch free, the rest free the nodes one by one in random
+# order, so both paths see blocks cut from a batch.
+@node_sizes = (24, 40, 56, 88, 120);
+$id = 0;
+$num_ops = 0;
+$total_block_size = 0;
+@live = ();
+
+sub retire {
+    my ($h) = @_;
+    if (int(rand 4) < 3) {
+        push @trace, "F $h->{first} $h->{count}";
+        $num_ops += 1;
+    } else {
+        my @ids = map { $h->{first} + $_ } (0 .. $h->{count} - 1);
+        while (@ids) {
+            my $k = int(rand @ids);
+            push @trace, "f $ids[$k]";
+            splice @ids, $k, 1;
+            $num_ops += 1;
+        }
+    }
+    push @trace, "f $h->{buffer}";
+    $num_ops += 1;
+}
+
+for ($i = 0;  $i < $num_handlers; $i += 1) {
+    if (@live >= $max_live) {
+        $k = int(rand @live);
+        retire($live[$k]);
+        splice @live, $k, 1;
+    }
+    $h = {};
+    $h->{first} = $id;
+    $h->{count} = int(rand 49) + 16;
+    $size = $node_sizes[int(rand @node_sizes)];
+    push @trace, "A $id $h->{count} $size";
+    $id += $h->{count};
+    $h->{buffer} = $id;
+    $size2 = int(rand 1985) + 64;
+    push @trace, "a $id $size2";
+    $id += 1;
+    $num_ops += 2;
+    $total_block_size += $h->{count} * $size + $size2;
+    push @live, $h;
+}
+foreach $h (@live) {
+    retire($h);
+}
+
+# Open output file
+open OUTFILE, ">$out_filename" or die "Cannot create $out_filename\n";
+
+# Calculate misc parameters
+$suggested_heap_size = $total_block_size + 100;
+
+print OUTFILE "$suggested_heap_size\n";
+print OUTFILE "$id\n";
+print OUTFILE "$num_ops\n";
+print OUTFILE "1\n";
+
+foreach $line (@trace) {
+    print OUTFILE "$line\n";
+}
+
+close OUTFILE;
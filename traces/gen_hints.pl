@@ -0,0 +1,125 @@
+#!/usr/bin/perl
+#!/usr/local/bin/perl
+
+$out_filename = $argv[0];
+$out_filename = "hints.rep" unless $out_filename;
+$plain_filename = "nohints.rep";
+$num_lists = $argv[1];
+$num_lists = 300 unless $num_lists;
+$max_live = 12;
+
+# Create trace
+# Up to $max_live linked lists grow side by side, one node at a
+# time, so consecutive nodes of a list are interleaved with the
+# nodes of the others. Each node is hinted near its predecessor.
+# Between nodes the program takes short-lived scratch buffers,
+# long-lived tables (some of them zeroed), zeroed buffers of a few
+# recycled sizes, and now and then a zeroed buffer big enough to get
+# a mapping of its own. A random list retires when a new one would
+# exceed $max_live. The same requests without the lifetime and
+# near hints go to $plain_filename, so the two can be compared.
+@node_sizes = (24, 40, 56, 88, 120);
+@zero_sizes = (256, 512, 1024);
+$id = 0;
+$num_ops = 0;
+$total_block_size = 0;
+@live = ();
+@scratch = ();
+@tables = ();
+
+sub emit {
+    my ($op) = @_;
+    push @trace, $op;
+    $num_ops += 1;
+}
+
+sub hinted {
+    my ($flags, $near, $size) = @_;
+    emit("h $id $flags $near $size");
+    $total_block_size += $size;
+    return $id++;
+}
+
+sub retire {
+    my ($l) = @_;
+    foreach $n (@{$l->{nodes}}) {
+        emit("f $n");
+    }
+}
+
+for ($i = 0;  $i < $num_lists; $i += 1) {
+    if (@live >= $max_live) {
+        $k = int(rand @live);
+        retire($live[$k]);
+        splice @live, $k, 1;
+    }
+    push @live, { size => $node_sizes[int(rand @node_sizes)], nodes => [] };
+
+    # grow the live lists a few nodes each, round robin
+    for ($j = 0; $j < 2; $j += 1) {
+        foreach $l (@live) {
+            $nodes = $l->{nodes};
+            if (@$nodes) {
+                push @$nodes, hinted("n", $nodes->[-1], $l->{size});
+            } else {
+                push @$nodes, hinted("-", -1, $l->{size});
+            }
+
+            # a scratch buffer that lives for a few requests
+            if (int(rand 3) == 0) {
+                push @scratch, hinted("s", -1, int(rand 449) + 64);
+            }
+            while (@scratch > 2) {
+                emit("f " . shift @scratch);
+            }
+        }
+    }
+
+    # a long-lived table, zeroed one time in two
+    $flags = int(rand 2) ? "lz" : "l";
+    push @tables, hinted($flags, -1, int(rand 3841) + 256);
+
+    # a zeroed buffer of a recycled size, freed right away
+    $z = hinted("z", -1, $zero_sizes[int(rand @zero_sizes)]);
+    emit("f $z");
+
+    # now and then a zeroed buffer that gets a mapping of its own
+    if ($i % 50 == 0) {
+        $z = hinted("z", -1, 150000);
+        emit("f $z");
+    }
+}
+foreach $l (@live) {
+    retire($l);
+}
+foreach $s (@scratch) {
+    emit("f $s");
+}
+foreach $t (@tables) {
+    emit("f $t");
+}
+
+# Calculate misc parameters
+$suggested_heap_size = $total_block_size + 100;
+
+# Write the hinted trace and the plain one, which keeps only MALLOC_ZERO
+# and the near ids, so mdriver still reports where the nodes landed
+foreach $file ($out_filename, $plain_filename) {
+    open OUTFILE, ">$file" or die "Cannot create $file\n";
+    print OUTFILE "$suggested_heap_size\n";
+    print OUTFILE "$id\n";
+    print OUTFILE "$num_ops\n";
+    print OUTFILE "1\n";
+
+    foreach $line (@trace) {
+        ($cmd, $hid, $flags, $near, $size) = split(" ", $line);
+        if ($file eq $plain_filename and $cmd eq "h") {
+            $flags = ($flags =~ /z/) ? "z" : "-";
+            print OUTFILE "h $hid $flags $near $size\n";
+        } else {
+            print OUTFILE "$line\n";
+        }
+    }
+
+    close OUTFILE;
+}
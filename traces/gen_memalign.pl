@@ -0,0 +1,70 @@
+#!/usr/bin/perl
+#!/usr/local/bin/perl
+
+$out_filename = $argv[0];
+$out_filename = "memalign.rep" unless $out_filename;
+$num_blocks = $argv[1];
+$num_blocks = 2400 unless $num_blocks;
+
+#print "Output file: $out_filename\n";
+#print "Number of blocks: $num_blocks\n";
+
+# Create trace
+# Make a series of malloc()s and memalign()s:
+#   half are plain small mallocs,
+#   a quarter are SIMD buffers aligned to 32 or 64 bytes,
+#   a quarter are I/O buffers aligned to the 4096-byte page.
+for ($i = 0;  $i < $num_blocks; $i += 1) {
+    $op = {};
+    $op->{seq} = $i;
+    $kind = int(rand 4);
+    if ($kind < 2) {
+        $op->{type} = "a";
+        $op->{size} = int(rand 512) + 1;
+    } elsif ($kind == 2) {
+        $op->{type} = "m";
+        $op->{align} = (32, 64)[int(rand 2)];
+        $op->{size} = int(rand 1024) + 1;
+    } else {
+        $op->{type} = "m";
+        $op->{align} = 4096;
+        $op->{size} = int(rand 8192) + 512;
+    }
+    $total_block_size += $op->{size};
+    push @trace, $op;
+}
+# Insert free()s in proper places
+for ($i = 0;  $i < $num_blocks; $i += 1) {
+    for ($minval = $i; $minval < $num_blocks + $i; $minval += 1) {
+        if (($trace[$minval]->{type} ne "f") && ($trace[$minval]->{seq} == $i)) {
+            last;
+        }
+    }
+    $pos = int(rand($num_blocks + $i - $minval - 1) + $minval + 1);
+    $op = {};
+    $op->{type} = "f";
+    $op->{seq} = $i;
+    splice @trace, $pos, 0, $op;
+}
+
+# Open output file
+open OUTFILE, ">$out_filename" or die "Cannot create $out_filename\n";
+
+# Calculate misc parameters
+$suggested_heap_size = $total_block_size + 100;
+$num_ops = 2*$num_blocks;
+
+print OUTFILE "$suggested_heap_size\n";
+print OUTFILE "$num_blocks\n";
+print OUTFILE "$num_ops\n";
+print OUTFILE "1\n";
+
+for ($i = 0;  $i < 2*$num_blocks; $i += 1) {
+    if ($trace[$i]->{type} eq "a") {
+        print OUTFILE "$trace[$i]->{type} $trace[$i]->{seq} $trace[$i]->{size}\n";
+    } elsif ($trace[$i]->{type} eq "m") {
+        print OUTFILE "$trace[$i]->{type} $trace[$i]->{seq} $trace[$i]->{align} $trace[$i]->{size}\n";
+    } else {
+        print OUTFILE "$trace[$i]->{type} $trace[$i]->{seq}\n";
+    }
+}